@@ -27,6 +27,7 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <cstddef>
 #include <cstdint>
 
 namespace lehmer_detail {
@@ -42,6 +43,7 @@ class mcg {
  
 public:
     using result_type = rtype;
+    using state_type = stype;
     static constexpr result_type min() { return result_type(0);  }
     static constexpr result_type max() { return ~result_type(0); }
 
@@ -56,6 +58,38 @@ public:
         state_ *= MCG_MULT;
     }
 
+    // The state stays odd, and an odd multiplier has order at most 2^(STYPE_BITS - 2).
+    static constexpr std::size_t period_pow2()
+    {
+        return STYPE_BITS - 2;
+    }
+
+    // Jump ahead by delta steps with O(log delta) multiplications, i.e.,
+    // multiply the state by MCG_MULT^delta.
+    void advance(stype delta)
+    {
+        stype acc_mult = 1;
+        stype cur_mult = MCG_MULT;
+        while (delta > 0) {
+            if (delta & 1)
+                acc_mult *= cur_mult;
+            cur_mult *= cur_mult;
+            delta >>= 1;
+        }
+        state_ *= acc_mult;
+    }
+
+    // As the period divides 2^STYPE_BITS, -delta steps forward is delta back.
+    void backstep(stype delta)
+    {
+        advance(-delta);
+    }
+
+    void discard(stype delta)
+    {
+        advance(delta);
+    }
+
     result_type operator()()
     {
         advance();
@@ -73,7 +107,6 @@ public:
     }
 
     // Not (yet) implemented:
-    //   - arbitrary jumpahead (see PCG code for an implementation)
     //   - I/O
     //   - Seeding from a seed_seq.
 };
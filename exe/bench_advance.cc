@@ -0,0 +1,105 @@
+/**
+ * @brief Benchmark the cost of jumping ahead, i.e., of handing a task its own block of the period.
+ *
+ * Each replica places N_TASKS engines at their blocks with substream() (one O(log n) advance each) and with split()
+ * (one advance per block from a running cursor). The xoshiro jump() of vigna.h, which costs a fixed number of next()
+ * calls, is shown for comparison.
+ *
+ * On x86_64 MACHINE:
+ *                         PCG::pcg32 substream(): gmean:        646; mean/sd:          652/90 us per 4096 tasks
+ *                             PCG::pcg32 split(): gmean:        307; mean/sd:          310/72 us per 4096 tasks
+ *                         PCG::pcg64 substream(): gmean:      2,546; mean/sd:       2,568/352 us per 4096 tasks
+ *                             PCG::pcg64 split(): gmean:      2,206; mean/sd:       2,240/496 us per 4096 tasks
+ *                    PCG::pcg64_fast substream(): gmean:      2,879; mean/sd:       2,901/459 us per 4096 tasks
+ *                     others::mcg128 substream(): gmean:      1,467; mean/sd:       1,492/461 us per 4096 tasks
+ *                others::mcg128_fast substream(): gmean:      1,491; mean/sd:       1,505/218 us per 4096 tasks
+ *                 others::splitmix64 substream(): gmean:        109; mean/sd:           109/7 us per 4096 tasks
+ *                     others::splitmix64 split(): gmean:         35; mean/sd:            35/3 us per 4096 tasks
+ *                         xoshiro::4x64++ jump(): gmean:      5,248; mean/sd:     5,357/1,291 us per 4096 tasks
+ *                      xoroshiro::16x64++ jump(): gmean:     68,508; mean/sd:   69,329/10,986 us per 4096 tasks
+ */
+#include "benchmark_utils.hh"
+#include "rprobs.hh"
+#include "substreams.hh"
+#include "vigna.h"
+#include "xoroshiro_wrapper.hh"
+
+#include <lehmer.hpp>
+#include <pcg_random.hpp>
+#include <splitmix.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t NAME_LENGTH = 48;
+constexpr std::size_t N_TASKS = 4096;
+
+// Sink for the first output of every substream, so the advances are not optimised away.
+std::uint64_t sink = 0;
+
+void bench(const std::string& name, const std::function<void()>& place_all)
+{
+    std::vector<std::size_t> times {};
+    for (std::size_t j = 0; j < N_REPLICA; j++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        place_all();
+        auto end = std::chrono::high_resolution_clock::now();
+        times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+    std::cout << std::setw(NAME_LENGTH) << name + ": " << describe(times) << " us per " << N_TASKS << " tasks"
+              << std::endl;
+}
+
+template <typename Engine> void bench_advance(const std::string& name)
+{
+    const Engine base { static_cast<typename Engine::result_type>(seed()) };
+    bench(name + " substream()", [&]() {
+        for (std::size_t i = 0; i < N_TASKS; i++) {
+            sink += substream(base, i, N_TASKS)();
+        }
+    });
+    bench(name + " split()", [&]() {
+        for (auto& engine : split(base, N_TASKS)) {
+            sink += engine();
+        }
+    });
+}
+
+template <typename Wrapper> void bench_jump(const std::string& name)
+{
+    bench(name + " jump()", [&]() {
+        XoroshiroStreamFactory<Wrapper> factory { seed() };
+        for (std::size_t i = 0; i < N_TASKS; i++) {
+            sink += (*factory.next_stream())();
+        }
+    });
+}
+
+} // namespace
+
+int main()
+{
+    bench_advance<pcg32>("PCG::pcg32");
+    bench_advance<pcg32_fast>("PCG::pcg32_fast");
+    bench_advance<pcg64>("PCG::pcg64");
+    bench_advance<pcg64_fast>("PCG::pcg64_fast");
+    bench_advance<mcg128>("others::mcg128");
+    bench_advance<mcg128_fast>("others::mcg128_fast");
+    bench_advance<splitmix32>("others::splitmix32");
+    bench_advance<splitmix64>("others::splitmix64");
+    bench_jump<XoroshiroWrapper<old::xoshiro_4x32_plus_plus, uint32_t, 4>>("xoshiro::4x32++");
+    bench_jump<XoroshiroWrapper<old::xoshiro_4x64_plus_plus, uint64_t, 4>>("xoshiro::4x64++");
+    bench_jump<XoroshiroWrapper<old::xoshiro_8x64_plus_plus, uint64_t, 8>>("xoshiro::8x64++");
+    bench_jump<XoroshiroWrapper<old::xoroshiro_16x64_plus_plus, uint64_t, 16>>("xoroshiro::16x64++");
+    std::cout << "(sink: " << sink % 2 << ")" << std::endl;
+    return EXIT_SUCCESS;
+}
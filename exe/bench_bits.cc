@@ -2,12 +2,14 @@
  *
  * @brief Benchmark various RNGs for generating random bits.
  *
- * Note: Those who failed TestU01 SmallCrush are NOT included.
+ * Note: Those who failed TestU01 SmallCrush are NOT included. Engines whose range is not a full 32- or 64-bit word are
+ * benchmarked through RangePacker, which packs their outputs into 32-bit words.
  */
 #include "bench_rand_conf.hh" // NOLINT
 
 #include "arch_utils.hh"
 #include "benchmark_utils.hh"
+#include "range_packer.hh"
 
 #include "rprobs.hh"
 #include "vigna.h"
@@ -95,6 +97,15 @@ template <typename T> void bench_bits_stl(T& rng, const std::string& name)
     std::cout << std::setw(NAME_LENGTH) << name + range + ": " << describe(times) << " us" << std::endl;
 }
 
+/**
+ * Benchmark an engine whose range is not a full word through RangePacker, so that it costs 32 bits of output.
+ */
+template <typename T> void bench_bits_packed(T& rng, const std::string& name)
+{
+    RangePacker<T> packer { rng };
+    bench_bits_stl<RangePacker<T>>(packer, name + " packed");
+}
+
 #if defined(MKL_FOUND) || defined(ARMPL_FOUND)
 void bench_bits_mkl(const MKL_INT type, const std::string& name)
 {
@@ -156,6 +167,12 @@ ABSL_ATTRIBUTE_ALWAYS_INLINE void bench_gsl(const gsl_rng_type* t)
     GslRngWrapper gsl_rand_wrapper { t };
     bench_bits_stl<GslRngWrapper>(gsl_rand_wrapper, "GSL::" + gsl_rand_wrapper.name());
 }
+
+void bench_gsl_packed(const gsl_rng_type* t)
+{
+    GslRngWrapper gsl_rand_wrapper { t };
+    bench_bits_packed<GslRngWrapper>(gsl_rand_wrapper, "GSL::" + gsl_rand_wrapper.name());
+}
 #endif
 
 [[maybe_unused]] void stl_main()
@@ -174,6 +191,12 @@ ABSL_ATTRIBUTE_ALWAYS_INLINE void bench_gsl(const gsl_rng_type* t)
 
     std::ranlux48 rng_ranlux48 { seed() };
     bench_bits_stl<std::ranlux48>(rng_ranlux48, "std::ranlux48");
+
+    std::ranlux24 rng_ranlux24 { static_cast<std::ranlux24::result_type>(seed()) };
+    bench_bits_packed<std::ranlux24>(rng_ranlux24, "std::ranlux24");
+
+    std::knuth_b rng_knuth_b { static_cast<std::knuth_b::result_type>(seed()) };
+    bench_bits_packed<std::knuth_b>(rng_knuth_b, "std::knuth_b");
 }
 
 [[maybe_unused]] void boost_main()
@@ -199,6 +222,36 @@ ABSL_ATTRIBUTE_ALWAYS_INLINE void bench_gsl(const gsl_rng_type* t)
 
     boost::random::ranlux64_4 rng_ranlux64_4 { static_cast<unsigned int>(seed()) };
     bench_bits_stl<boost::random::ranlux64_4>(rng_ranlux64_4, "boost::random::ranlux64_4");
+
+    boost::random::ranlux24 rng_ranlux24 { static_cast<unsigned int>(seed()) };
+    bench_bits_packed<boost::random::ranlux24>(rng_ranlux24, "boost::random::ranlux24");
+
+    boost::random::knuth_b rng_knuth_b { static_cast<unsigned int>(seed()) };
+    bench_bits_packed<boost::random::knuth_b>(rng_knuth_b, "boost::random::knuth_b");
+
+    boost::random::minstd_rand0 rng_minstd_rand0 { static_cast<unsigned int>(seed()) };
+    bench_bits_packed<boost::random::minstd_rand0>(rng_minstd_rand0, "boost::random::minstd_rand0");
+
+    boost::random::minstd_rand rng_minstd_rand { static_cast<unsigned int>(seed()) };
+    bench_bits_packed<boost::random::minstd_rand>(rng_minstd_rand, "boost::random::minstd_rand");
+
+    boost::random::ranlux24_base rng_ranlux24_base { static_cast<unsigned int>(seed()) };
+    bench_bits_packed<boost::random::ranlux24_base>(rng_ranlux24_base, "boost::random::ranlux24_base");
+
+    boost::random::ecuyer1988 rng_ecuyer1988 { static_cast<unsigned int>(seed()) };
+    bench_bits_packed<boost::random::ecuyer1988>(rng_ecuyer1988, "boost::random::ecuyer1988");
+
+    boost::random::kreutzer1986 rng_kreutzer1986 { static_cast<unsigned int>(seed()) };
+    bench_bits_packed<boost::random::kreutzer1986>(rng_kreutzer1986, "boost::random::kreutzer1986");
+
+    boost::random::hellekalek1995 rng_hellekalek1995 { static_cast<unsigned int>(seed()) };
+    bench_bits_packed<boost::random::hellekalek1995>(rng_hellekalek1995, "boost::random::hellekalek1995");
+
+    boost::random::ranlux3 rng_ranlux3 { static_cast<unsigned int>(seed()) };
+    bench_bits_packed<boost::random::ranlux3>(rng_ranlux3, "boost::random::ranlux3");
+
+    boost::random::ranlux4 rng_ranlux4 { static_cast<unsigned int>(seed()) };
+    bench_bits_packed<boost::random::ranlux4>(rng_ranlux4, "boost::random::ranlux4");
 #endif
 }
 
@@ -273,6 +326,13 @@ ABSL_ATTRIBUTE_ALWAYS_INLINE void bench_gsl(const gsl_rng_type* t)
     bench_gsl(gsl_rng_taus);
     bench_gsl(gsl_rng_taus2);
     bench_gsl(gsl_rng_gfsr4);
+    bench_gsl_packed(gsl_rng_ranlxs0);
+    bench_gsl_packed(gsl_rng_ranlxs1);
+    bench_gsl_packed(gsl_rng_ranlxs2);
+    bench_gsl_packed(gsl_rng_ranlux);
+    bench_gsl_packed(gsl_rng_ranlux389);
+    bench_gsl_packed(gsl_rng_cmrg);
+    bench_gsl_packed(gsl_rng_mrg);
 #endif
 }
 
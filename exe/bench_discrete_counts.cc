@@ -0,0 +1,256 @@
+/**
+ * @brief Benchmark Poisson and binomial samplers.
+ *
+ * Read counts per region and coverage jitter need counts with wildly varying means. Each sampler is run with fixed
+ * parameters (where setup can be amortised) and in batched mode, where every element has its own parameters.
+ *
+ * Note: Abseil has no binomial distribution; GSL and MKL use their own engines (MT19937 and SFMT19937).
+ */
+#include "bench_rand_conf.hh" // NOLINT
+
+#include "benchmark_utils.hh"
+#include "class_utils.hh"
+#include "discrete_counts.hh"
+#include "rprobs.hh"
+
+#ifdef MKL_FOUND
+#include <mkl.h>
+#endif
+
+#ifdef GSL_FOUND
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_rng.h>
+#endif
+
+#include <boost/random/binomial_distribution.hpp>
+#include <boost/random/poisson_distribution.hpp>
+
+#ifdef absl_FOUND
+#include <absl/random/distributions.h>
+#include <absl/random/poisson_distribution.h>
+#endif
+
+#include <pcg_random.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t NAME_LENGTH = 56;
+// std and GSL take microseconds per variate at some parameters, so fewer replicas than elsewhere.
+constexpr std::size_t N_COUNT_REPLICA = 20;
+
+void bench(const std::string& name, const std::function<void()>& fill_n_times)
+{
+    std::vector<std::size_t> times {};
+    for (std::size_t j = 0; j < N_COUNT_REPLICA; j++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (std::size_t i = 0; i < N_TIMES; i++) {
+            fill_n_times();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+    std::cout << std::setw(NAME_LENGTH) << name + ": " << describe(times) << " us" << std::endl;
+}
+
+struct Samplers {
+    pcg64_fast engine { seed() };
+    std::vector<std::int64_t> counts = std::vector<std::int64_t>(N_BASES);
+#ifdef GSL_FOUND
+    gsl_rng* gsl_engine = gsl_rng_alloc(gsl_rng_mt19937);
+#endif
+#ifdef MKL_FOUND
+    VSLStreamStatePtr stream = nullptr;
+    std::vector<int> int_counts = std::vector<int>(N_BASES);
+#endif
+
+    Samplers()
+    {
+#ifdef GSL_FOUND
+        gsl_rng_set(gsl_engine, seed());
+#endif
+#ifdef MKL_FOUND
+        vslNewStream(&stream, VSL_BRNG_SFMT19937, static_cast<MKL_UINT>(seed()));
+#endif
+    }
+    ~Samplers()
+    {
+#ifdef GSL_FOUND
+        gsl_rng_free(gsl_engine);
+#endif
+#ifdef MKL_FOUND
+        vslDeleteStream(&stream);
+#endif
+    }
+    DELETE_COPY_MOVE(Samplers)
+};
+
+void bench_poisson(Samplers& s, const double mean)
+{
+    const std::string suffix = "Poisson(" + std::to_string(mean).substr(0, 8) + ")";
+    bench("std::poisson_distribution " + suffix, [&]() {
+        std::poisson_distribution<std::int64_t> dist { mean };
+        std::generate_n(s.counts.begin(), N_BASES, [&]() { return dist(s.engine); });
+    });
+    bench("boost::random::poisson_distribution " + suffix, [&]() {
+        boost::random::poisson_distribution<std::int64_t, double> dist { mean };
+        std::generate_n(s.counts.begin(), N_BASES, [&]() { return dist(s.engine); });
+    });
+#ifdef absl_FOUND
+    bench("absl::poisson_distribution " + suffix, [&]() {
+        absl::poisson_distribution<std::int64_t> dist { mean };
+        std::generate_n(s.counts.begin(), N_BASES, [&]() { return dist(s.engine); });
+    });
+#endif
+#ifdef GSL_FOUND
+    bench("GSL::gsl_ran_poisson " + suffix, [&]() {
+        std::generate_n(s.counts.begin(), N_BASES, [&]() { return gsl_ran_poisson(s.gsl_engine, mean); });
+    });
+#endif
+#ifdef MKL_FOUND
+    bench("MKL::viRngPoisson " + suffix, [&]() {
+        viRngPoisson(VSL_RNG_METHOD_POISSON_PTPE, s.stream, N_BASES, s.int_counts.data(), mean);
+    });
+#endif
+    bench("PoissonSampler " + suffix, [&]() { PoissonSampler { mean }.sample(s.engine, s.counts.data(), N_BASES); });
+}
+
+void bench_binomial(Samplers& s, const std::int64_t trials, const double p)
+{
+    const std::string suffix = "Binomial(" + std::to_string(trials) + ", " + std::to_string(p).substr(0, 6) + ")";
+    bench("std::binomial_distribution " + suffix, [&]() {
+        std::binomial_distribution<std::int64_t> dist { trials, p };
+        std::generate_n(s.counts.begin(), N_BASES, [&]() { return dist(s.engine); });
+    });
+    bench("boost::random::binomial_distribution " + suffix, [&]() {
+        boost::random::binomial_distribution<std::int64_t, double> dist { trials, p };
+        std::generate_n(s.counts.begin(), N_BASES, [&]() { return dist(s.engine); });
+    });
+#ifdef GSL_FOUND
+    bench("GSL::gsl_ran_binomial " + suffix, [&]() {
+        std::generate_n(s.counts.begin(), N_BASES,
+            [&]() { return gsl_ran_binomial(s.gsl_engine, p, static_cast<unsigned int>(trials)); });
+    });
+#endif
+#ifdef MKL_FOUND
+    bench("MKL::viRngBinomial " + suffix, [&]() {
+        viRngBinomial(
+            VSL_RNG_METHOD_BINOMIAL_BTPE, s.stream, N_BASES, s.int_counts.data(), static_cast<int>(trials), p);
+    });
+#endif
+    bench("BinomialSampler " + suffix,
+        [&]() { BinomialSampler { trials, p }.sample(s.engine, s.counts.data(), N_BASES); });
+}
+
+/**
+ * Every element has its own mean, drawn log-uniformly from [0.1, 100,000].
+ */
+void bench_poisson_batched(Samplers& s)
+{
+    std::vector<double> means(N_BASES);
+    std::generate(means.begin(), means.end(), [&]() { return std::pow(10.0, -1.0 + 6.0 * uniform01(s.engine)); });
+    const std::string suffix = "Poisson (batched)";
+
+    bench("std::poisson_distribution " + suffix, [&]() {
+        for (std::size_t i = 0; i < N_BASES; i++) {
+            s.counts[i] = std::poisson_distribution<std::int64_t> { means[i] }(s.engine);
+        }
+    });
+    bench("boost::random::poisson_distribution " + suffix, [&]() {
+        for (std::size_t i = 0; i < N_BASES; i++) {
+            s.counts[i] = boost::random::poisson_distribution<std::int64_t, double> { means[i] }(s.engine);
+        }
+    });
+#ifdef absl_FOUND
+    bench("absl::Poisson " + suffix, [&]() {
+        for (std::size_t i = 0; i < N_BASES; i++) {
+            s.counts[i] = absl::Poisson<std::int64_t>(s.engine, means[i]);
+        }
+    });
+#endif
+#ifdef GSL_FOUND
+    bench("GSL::gsl_ran_poisson " + suffix, [&]() {
+        for (std::size_t i = 0; i < N_BASES; i++) {
+            s.counts[i] = gsl_ran_poisson(s.gsl_engine, means[i]);
+        }
+    });
+#endif
+#ifdef MKL_FOUND
+    bench("MKL::viRngPoissonV " + suffix, [&]() {
+        viRngPoissonV(VSL_RNG_METHOD_POISSONV_POISNORM, s.stream, N_BASES, s.int_counts.data(), means.data());
+    });
+#endif
+    bench("sample_poisson " + suffix, [&]() { sample_poisson(s.engine, means.data(), s.counts.data(), N_BASES); });
+}
+
+/**
+ * Every element has its own number of trials, drawn log-uniformly from [10, 100,000], and its own probability.
+ */
+void bench_binomial_batched(Samplers& s)
+{
+    std::vector<std::int64_t> trials(N_BASES);
+    std::vector<double> probs(N_BASES);
+    std::generate(trials.begin(), trials.end(),
+        [&]() { return static_cast<std::int64_t>(std::pow(10.0, 1.0 + 4.0 * uniform01(s.engine))); });
+    std::generate(probs.begin(), probs.end(), [&]() { return uniform01(s.engine); });
+    const std::string suffix = "Binomial (batched)";
+
+    bench("std::binomial_distribution " + suffix, [&]() {
+        for (std::size_t i = 0; i < N_BASES; i++) {
+            s.counts[i] = std::binomial_distribution<std::int64_t> { trials[i], probs[i] }(s.engine);
+        }
+    });
+    bench("boost::random::binomial_distribution " + suffix, [&]() {
+        for (std::size_t i = 0; i < N_BASES; i++) {
+            s.counts[i] = boost::random::binomial_distribution<std::int64_t, double> { trials[i], probs[i] }(s.engine);
+        }
+    });
+#ifdef GSL_FOUND
+    bench("GSL::gsl_ran_binomial " + suffix, [&]() {
+        for (std::size_t i = 0; i < N_BASES; i++) {
+            s.counts[i] = gsl_ran_binomial(s.gsl_engine, probs[i], static_cast<unsigned int>(trials[i]));
+        }
+    });
+#endif
+#ifdef MKL_FOUND
+    // MKL has no vector-parameter binomial, so one variate per call.
+    bench("MKL::viRngBinomial " + suffix, [&]() {
+        for (std::size_t i = 0; i < N_BASES; i++) {
+            viRngBinomial(VSL_RNG_METHOD_BINOMIAL_BTPE, s.stream, 1, s.int_counts.data() + i,
+                static_cast<int>(trials[i]), probs[i]);
+        }
+    });
+#endif
+    bench("sample_binomial " + suffix,
+        [&]() { sample_binomial(s.engine, trials.data(), probs.data(), s.counts.data(), N_BASES); });
+}
+
+} // namespace
+
+int main()
+{
+    Samplers s {};
+    for (const double mean : { 0.5, 5.0, 50.0, 5000.0, 5000000.0 }) {
+        bench_poisson(s, mean);
+    }
+    for (const auto& [trials, p] : std::vector<std::pair<std::int64_t, double>> {
+             { 100, 0.02 }, { 100, 0.3 }, { 10000, 0.01 }, { 10000000, 0.4 } }) {
+        bench_binomial(s, trials, p);
+    }
+    bench_poisson_batched(s);
+    bench_binomial_batched(s);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+/**
+ * @brief Benchmark giving randomness to many short tasks running on several threads.
+ *
+ * Every task draws TASK_DRAWS numbers. The engine is either constructed per task (seeded with SplitMix64, or
+ * std::mt19937 seeded with an integer), shared behind a mutex, or leased from an EnginePool of one jump-separated
+ * engine per thread.
+ *
+ * On x86_64 MACHINE with 1 core, so there is no real contention; a thread preempted while holding a lease makes the
+ * others yield, hence the pool is no faster than the mutex here:
+ *     per-task xoshiro::4x64++ (seeded_state) x1: gmean:     20,961; mean/sd:    21,001/1,380 us per 65536 tasks
+ *        per-task std::mt19937 (integer seed) x1: gmean:    526,047; mean/sd:  527,333/37,993 us per 65536 tasks
+ *                mutex-shared xoshiro::4x64++ x1: gmean:     12,755; mean/sd:    12,976/2,569 us per 65536 tasks
+ *                 EnginePool<xoshiro::4x64++> x1: gmean:     12,739; mean/sd:    12,930/2,418 us per 65536 tasks
+ *     per-task xoshiro::4x64++ (seeded_state) x4: gmean:     18,757; mean/sd:    18,812/1,536 us per 65536 tasks
+ *        per-task std::mt19937 (integer seed) x4: gmean:    541,648; mean/sd:  542,149/23,805 us per 65536 tasks
+ *                mutex-shared xoshiro::4x64++ x4: gmean:     12,374; mean/sd:    12,610/2,742 us per 65536 tasks
+ *                 EnginePool<xoshiro::4x64++> x4: gmean:     19,022; mean/sd:      19,042/891 us per 65536 tasks
+ */
+#include "benchmark_utils.hh"
+#include "engine_pool.hh"
+#include "rprobs.hh"
+#include "vigna.h"
+#include "xoroshiro_wrapper.hh"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Engine = XoroshiroWrapper<old::xoshiro_4x64_plus_plus, uint64_t, 4>;
+
+constexpr std::size_t NAME_LENGTH = 48;
+constexpr std::size_t N_TASKS = 1UL << 16;
+constexpr std::size_t TASK_DRAWS = 64;
+constexpr std::size_t N_POOL_REPLICA = 20;
+
+std::atomic<std::uint64_t> sink { 0 };
+
+/**
+ * Run N_TASKS tasks split evenly among @p n_threads threads; @p task gets the global task index.
+ */
+void bench(const std::string& name, const std::size_t n_threads, const std::function<std::uint64_t(std::size_t)>& task)
+{
+    std::vector<std::size_t> times {};
+    for (std::size_t j = 0; j < N_POOL_REPLICA; j++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> workers {};
+        for (std::size_t t = 0; t < n_threads; t++) {
+            workers.emplace_back([&, t]() {
+                std::uint64_t local_sink = 0;
+                for (std::size_t i = t * N_TASKS / n_threads; i < (t + 1) * N_TASKS / n_threads; i++) {
+                    local_sink += task(i);
+                }
+                sink += local_sink;
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+    std::cout << std::setw(NAME_LENGTH) << name + " x" + std::to_string(n_threads) + ": " << describe(times)
+              << " us per " << N_TASKS << " tasks" << std::endl;
+}
+
+template <typename Rng> std::uint64_t draw_task(Rng& engine)
+{
+    std::uint64_t sum = 0;
+    for (std::size_t k = 0; k < TASK_DRAWS; k++) {
+        sum += engine();
+    }
+    return sum;
+}
+
+} // namespace
+
+int main()
+{
+    const std::uint64_t master_seed = seed();
+    for (const std::size_t n_threads : thread_counts()) {
+        bench("per-task xoshiro::4x64++ (seeded_state)", n_threads, [master_seed](const std::size_t i) {
+            Engine engine { Engine::seeded_state(master_seed + i) };
+            return draw_task(engine);
+        });
+        bench("per-task std::mt19937 (integer seed)", n_threads, [master_seed](const std::size_t i) {
+            std::mt19937 engine { static_cast<std::mt19937::result_type>(master_seed + i) };
+            return draw_task(engine);
+        });
+
+        Engine shared { Engine::seeded_state(master_seed) };
+        std::mutex shared_mutex;
+        bench("mutex-shared xoshiro::4x64++", n_threads, [&](std::size_t /* unused */) {
+            std::lock_guard<std::mutex> lock { shared_mutex };
+            return draw_task(shared);
+        });
+
+        EnginePool<Engine> pool { jumped_states<Engine>(master_seed, n_threads) };
+        bench("EnginePool<xoshiro::4x64++>", n_threads, [&pool](std::size_t /* unused */) {
+            auto lease = pool.acquire();
+            return draw_task(*lease);
+        });
+    }
+    std::cout << "(sink: " << sink % 2 << ")" << std::endl;
+    return EXIT_SUCCESS;
+}
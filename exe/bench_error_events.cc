@@ -0,0 +1,167 @@
+/**
+ * @brief Benchmark drawing per-base sequencing error events from Phred qualities.
+ *
+ * The baseline draws one floating-point uniform per base and compares it with p(Q). ErrorMaskKernel compares raw
+ * engine words against integer thresholds instead, either one by one or with SIMD, and packs the result into a
+ * bitmask. GeometricSkipSampler draws only once per event, which pays off at high qualities.
+ *
+ * Each method is run on an Illumina-like profile and at constant qualities of 10 to 40, i.e., error rates of 1E-1 to
+ * 1E-4.
+ *
+ * On x86_64 MACHINE (AVX-512):
+ *   Illumina-like: std::uniform_real_distribution < p(Q): gmean:     11,168; mean/sd:    11,239/1,316 us
+ *        Illumina-like: boost::random::uniform_01 < p(Q): gmean:      5,738; mean/sd:       5,775/870 us
+ *           Illumina-like: ErrorMaskKernel::apply_scalar: gmean:      3,162; mean/sd:       3,175/333 us
+ *      Illumina-like: ErrorMaskKernel::operator() (SIMD): gmean:      1,780; mean/sd:        1,783/98 us
+ *                    Illumina-like: GeometricSkipSampler: gmean:      4,151; mean/sd:       4,158/259 us
+ *             Q10: std::uniform_real_distribution < p(Q): gmean:     10,564; mean/sd:      10,580/659 us
+ *                  Q10: boost::random::uniform_01 < p(Q): gmean:      6,395; mean/sd:       6,422/590 us
+ *                     Q10: ErrorMaskKernel::apply_scalar: gmean:      3,155; mean/sd:       3,165/261 us
+ *                Q10: ErrorMaskKernel::operator() (SIMD): gmean:      1,933; mean/sd:       1,941/179 us
+ *                              Q10: GeometricSkipSampler: gmean:     27,581; mean/sd:    27,745/3,142 us
+ *             Q20: std::uniform_real_distribution < p(Q): gmean:      8,904; mean/sd:     9,089/1,872 us
+ *                  Q20: boost::random::uniform_01 < p(Q): gmean:      5,941; mean/sd:       6,009/887 us
+ *                     Q20: ErrorMaskKernel::apply_scalar: gmean:      2,586; mean/sd:       2,615/394 us
+ *                Q20: ErrorMaskKernel::operator() (SIMD): gmean:      1,753; mean/sd:       1,774/338 us
+ *                              Q20: GeometricSkipSampler: gmean:      3,636; mean/sd:       3,684/634 us
+ *             Q30: std::uniform_real_distribution < p(Q): gmean:     10,573; mean/sd:    10,793/2,219 us
+ *                  Q30: boost::random::uniform_01 < p(Q): gmean:      6,017; mean/sd:       6,083/888 us
+ *                     Q30: ErrorMaskKernel::apply_scalar: gmean:      2,552; mean/sd:       2,590/458 us
+ *                Q30: ErrorMaskKernel::operator() (SIMD): gmean:      1,920; mean/sd:       1,937/286 us
+ *                              Q30: GeometricSkipSampler: gmean:      1,007; mean/sd:       1,016/146 us
+ *             Q40: std::uniform_real_distribution < p(Q): gmean:      9,221; mean/sd:     9,458/2,126 us
+ *                  Q40: boost::random::uniform_01 < p(Q): gmean:      6,055; mean/sd:     6,196/1,339 us
+ *                     Q40: ErrorMaskKernel::apply_scalar: gmean:      3,386; mean/sd:       3,410/426 us
+ *                Q40: ErrorMaskKernel::operator() (SIMD): gmean:      2,072; mean/sd:       2,080/199 us
+ *                              Q40: GeometricSkipSampler: gmean:      1,236; mean/sd:       1,243/132 us
+ *
+ * Skipping wins from Q30 on. When qualities change at every base (the Illumina-like profile draws them
+ * independently) the run-walking overhead dominates and the SIMD kernel is faster.
+ */
+#include "alias_table.hh"
+#include "benchmark_utils.hh"
+#include "error_mask.hh"
+#include "geometric_skip.hh"
+#include "rprobs.hh"
+
+#include <boost/random/uniform_01.hpp>
+
+#include <pcg_random.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t NAME_LENGTH = 64;
+constexpr std::size_t N_QUALS = 42;
+
+void bench(const std::string& name, const std::function<void()>& fill_n_times)
+{
+    std::vector<std::size_t> times {};
+    for (std::size_t j = 0; j < N_REPLICA; j++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        fill_n_times();
+        auto end = std::chrono::high_resolution_clock::now();
+        times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+    std::cout << std::setw(NAME_LENGTH) << name + ": " << describe(times) << " us" << std::endl;
+}
+
+/**
+ * Qualities of N_TIMES reads, drawn from an Illumina-like profile centred at Q35.
+ */
+std::vector<std::uint8_t> make_quals(pcg64_fast& engine)
+{
+    std::vector<double> weights(N_QUALS);
+    for (std::size_t q = 0; q < N_QUALS; ++q) {
+        const double d = (static_cast<double>(q) - 35.0) / 5.0;
+        weights[q] = std::exp(-0.5 * d * d) + 1E-3;
+    }
+    std::vector<std::uint8_t> quals(N_BASES * N_TIMES);
+    AliasTable { weights }.sample(engine, quals.data(), quals.size());
+    return quals;
+}
+
+/**
+ * Qualities of N_TIMES reads, all at the same quality.
+ */
+std::vector<std::uint8_t> make_const_quals(const std::uint8_t qual)
+{
+    return std::vector<std::uint8_t>(N_BASES * N_TIMES, qual);
+}
+
+void bench_profile(const std::string& profile, const std::vector<std::uint8_t>& quals, pcg64_fast& engine)
+{
+    std::vector<std::uint64_t> mask((N_BASES + 63) / 64);
+    std::vector<std::uint32_t> bits(N_BASES);
+
+    std::vector<double> probs(N_QUALS);
+    for (std::size_t q = 0; q < N_QUALS; ++q) {
+        probs[q] = std::pow(10.0, -static_cast<double>(q) / 10.0);
+    }
+    const ErrorMaskKernel kernel {};
+    const GeometricSkipSampler skip_sampler {};
+
+    bench(profile + " std::uniform_real_distribution < p(Q)", [&]() {
+        std::uniform_real_distribution<double> dist { 0.0, 1.0 };
+        for (std::size_t i = 0; i < N_TIMES; i++) {
+            const std::uint8_t* read_quals = quals.data() + i * N_BASES;
+            for (std::size_t pos = 0; pos < N_BASES; pos++) {
+                if (pos % 64 == 0) {
+                    mask[pos / 64] = 0;
+                }
+                mask[pos / 64] |= static_cast<std::uint64_t>(dist(engine) < probs[read_quals[pos]]) << (pos % 64);
+            }
+        }
+    });
+    bench(profile + " boost::random::uniform_01 < p(Q)", [&]() {
+        boost::random::uniform_01<double> dist {};
+        for (std::size_t i = 0; i < N_TIMES; i++) {
+            const std::uint8_t* read_quals = quals.data() + i * N_BASES;
+            for (std::size_t pos = 0; pos < N_BASES; pos++) {
+                if (pos % 64 == 0) {
+                    mask[pos / 64] = 0;
+                }
+                mask[pos / 64] |= static_cast<std::uint64_t>(dist(engine) < probs[read_quals[pos]]) << (pos % 64);
+            }
+        }
+    });
+    bench(profile + " ErrorMaskKernel::apply_scalar", [&]() {
+        for (std::size_t i = 0; i < N_TIMES; i++) {
+            fill_u32(engine, bits.data(), N_BASES);
+            kernel.apply_scalar(quals.data() + i * N_BASES, bits.data(), N_BASES, mask.data());
+        }
+    });
+    bench(profile + " ErrorMaskKernel::operator() (SIMD)", [&]() {
+        for (std::size_t i = 0; i < N_TIMES; i++) {
+            kernel(engine, quals.data() + i * N_BASES, N_BASES, mask.data());
+        }
+    });
+    bench(profile + " GeometricSkipSampler", [&]() {
+        for (std::size_t i = 0; i < N_TIMES; i++) {
+            skip_sampler(engine, quals.data() + i * N_BASES, N_BASES, mask.data());
+        }
+    });
+}
+
+} // namespace
+
+int main()
+{
+    pcg64_fast engine { seed() };
+    bench_profile("Illumina-like:", make_quals(engine), engine);
+    for (const std::uint8_t qual : { 10, 20, 30, 40 }) {
+        bench_profile("Q" + std::to_string(qual) + ":", make_const_quals(qual), engine);
+    }
+    return EXIT_SUCCESS;
+}
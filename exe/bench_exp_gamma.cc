@@ -0,0 +1,186 @@
+/**
+ * @brief Benchmark exponential and gamma samplers.
+ *
+ * Coverage-bias and GC-bias models draw gamma-distributed multipliers per fragment. Native samplers are built on the
+ * bulk uniform path and the vectorised vlog(); the others are called once per variate, except MKL.
+ *
+ * Note: GSL and MKL use their own engines (MT19937 and SFMT19937).
+ *
+ * On x86_64 MACHINE (without GSL and MKL):
+ *                                       std::log (loop): gmean:     10,091; mean/sd:    10,249/2,293 us
+ *                                                  vlog: gmean:      3,034; mean/sd:       3,036/130 us
+ *                         std::exponential_distribution: gmean:    267,766; mean/sd:  268,474/20,604 us
+ *               boost::random::exponential_distribution: gmean:     12,987; mean/sd:    13,355/3,132 us
+ *                                 -std::log(U) (scalar): gmean:    248,659; mean/sd:  249,980/26,996 us
+ *                               fill_exponential (vlog): gmean:      9,287; mean/sd:     9,462/2,363 us
+ *                             ZigguratExponential::fill: gmean:     13,988; mean/sd:      13,997/511 us
+ *                   std::gamma_distribution Gamma(0.50): gmean:    688,214; mean/sd:  689,480/44,224 us
+ *         boost::random::gamma_distribution Gamma(0.50): gmean:    741,871; mean/sd:  745,156/73,225 us
+ *                        GammaSampler::fill Gamma(0.50): gmean:    545,611; mean/sd:  547,635/49,254 us
+ *                   std::gamma_distribution Gamma(2.00): gmean:    357,787; mean/sd:  358,829/29,186 us
+ *         boost::random::gamma_distribution Gamma(2.00): gmean:  1,749,188; mean/sd: 1,752,049/101,952 us
+ *                        GammaSampler::fill Gamma(2.00): gmean:    245,840; mean/sd:  246,829/23,542 us
+ *                   std::gamma_distribution Gamma(20.0): gmean:    396,961; mean/sd:  402,546/75,210 us
+ *         boost::random::gamma_distribution Gamma(20.0): gmean:  1,990,048; mean/sd: 1,996,409/164,398 us
+ *                        GammaSampler::fill Gamma(20.0): gmean:    247,097; mean/sd:  249,392/34,543 us
+ */
+#include "bench_rand_conf.hh" // NOLINT
+
+#include "benchmark_utils.hh"
+#include "class_utils.hh"
+#include "continuous_dists.hh"
+#include "engine_utils.hh"
+#include "rprobs.hh"
+
+#ifdef MKL_FOUND
+#include <mkl.h>
+#endif
+
+#ifdef GSL_FOUND
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_rng.h>
+#endif
+
+#include <boost/random/exponential_distribution.hpp>
+#include <boost/random/gamma_distribution.hpp>
+
+#include <pcg_random.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t NAME_LENGTH = 56;
+// std and Boost gamma take a few hundred nanoseconds per variate, so fewer replicas than elsewhere.
+constexpr std::size_t N_CONTINUOUS_REPLICA = 20;
+
+void bench(const std::string& name, const std::function<void()>& fill_once)
+{
+    std::vector<std::size_t> times {};
+    for (std::size_t j = 0; j < N_CONTINUOUS_REPLICA; j++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (std::size_t i = 0; i < N_TIMES; i++) {
+            fill_once();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+    std::cout << std::setw(NAME_LENGTH) << name + ": " << describe(times) << " us" << std::endl;
+}
+
+struct Samplers {
+    pcg64_fast engine { seed() };
+    std::vector<double> values = std::vector<double>(N_BASES);
+#ifdef GSL_FOUND
+    gsl_rng* gsl_engine = gsl_rng_alloc(gsl_rng_mt19937);
+#endif
+#ifdef MKL_FOUND
+    VSLStreamStatePtr stream = nullptr;
+#endif
+
+    Samplers()
+    {
+#ifdef GSL_FOUND
+        gsl_rng_set(gsl_engine, seed());
+#endif
+#ifdef MKL_FOUND
+        vslNewStream(&stream, VSL_BRNG_SFMT19937, static_cast<MKL_UINT>(seed()));
+#endif
+    }
+    ~Samplers()
+    {
+#ifdef GSL_FOUND
+        gsl_rng_free(gsl_engine);
+#endif
+#ifdef MKL_FOUND
+        vslDeleteStream(&stream);
+#endif
+    }
+    DELETE_COPY_MOVE(Samplers)
+};
+
+void bench_log(Samplers& s)
+{
+    std::vector<double> inputs(N_BASES);
+    fill_uniform01_positive(s.engine, inputs.data(), N_BASES);
+    bench("std::log (loop)", [&]() {
+        std::transform(inputs.begin(), inputs.end(), s.values.begin(), [](double x) { return std::log(x); });
+    });
+    bench("vlog", [&]() { vlog(inputs.data(), s.values.data(), N_BASES); });
+}
+
+void bench_exponential(Samplers& s)
+{
+    bench("std::exponential_distribution", [&]() {
+        std::exponential_distribution<double> dist { 1.0 };
+        std::generate_n(s.values.begin(), N_BASES, [&]() { return dist(s.engine); });
+    });
+    bench("boost::random::exponential_distribution", [&]() {
+        boost::random::exponential_distribution<double> dist { 1.0 };
+        std::generate_n(s.values.begin(), N_BASES, [&]() { return dist(s.engine); });
+    });
+#ifdef GSL_FOUND
+    bench("GSL::gsl_ran_exponential", [&]() {
+        std::generate_n(s.values.begin(), N_BASES, [&]() { return gsl_ran_exponential(s.gsl_engine, 1.0); });
+    });
+#endif
+#ifdef MKL_FOUND
+    bench("MKL::vdRngExponential", [&]() {
+        vdRngExponential(VSL_RNG_METHOD_EXPONENTIAL_ICDF, s.stream, N_BASES, s.values.data(), 0.0, 1.0);
+    });
+#endif
+    bench("-std::log(U) (scalar)", [&]() {
+        std::generate_n(s.values.begin(), N_BASES, [&]() { return -std::log(1.0 - uniform01(s.engine)); });
+    });
+    bench("fill_exponential (vlog)", [&]() { fill_exponential(s.engine, s.values.data(), N_BASES); });
+    const ZigguratExponential ziggurat {};
+    bench("ZigguratExponential::fill", [&]() { ziggurat.fill(s.engine, s.values.data(), N_BASES); });
+}
+
+void bench_gamma(Samplers& s, const double shape)
+{
+    const std::string suffix = " Gamma(" + std::to_string(shape).substr(0, 4) + ")";
+    bench("std::gamma_distribution" + suffix, [&]() {
+        std::gamma_distribution<double> dist { shape, 1.0 };
+        std::generate_n(s.values.begin(), N_BASES, [&]() { return dist(s.engine); });
+    });
+    bench("boost::random::gamma_distribution" + suffix, [&]() {
+        boost::random::gamma_distribution<double> dist { shape, 1.0 };
+        std::generate_n(s.values.begin(), N_BASES, [&]() { return dist(s.engine); });
+    });
+#ifdef GSL_FOUND
+    bench("GSL::gsl_ran_gamma" + suffix, [&]() {
+        std::generate_n(s.values.begin(), N_BASES, [&]() { return gsl_ran_gamma(s.gsl_engine, shape, 1.0); });
+    });
+#endif
+#ifdef MKL_FOUND
+    bench("MKL::vdRngGamma" + suffix, [&]() {
+        vdRngGamma(VSL_RNG_METHOD_GAMMA_GNORM, s.stream, N_BASES, s.values.data(), shape, 0.0, 1.0);
+    });
+#endif
+    const GammaSampler gamma { shape };
+    bench("GammaSampler::fill" + suffix, [&]() { gamma.fill(s.engine, s.values.data(), N_BASES); });
+}
+
+} // namespace
+
+int main()
+{
+    Samplers s {};
+    bench_log(s);
+    bench_exponential(s);
+    for (const double shape : { 0.5, 2.0, 20.0 }) {
+        bench_gamma(s, shape);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,135 @@
+/**
+ * @brief Benchmark the layout of per-thread engine states: packed in one array, padded to 64 or 128 bytes, or
+ * thread-local.
+ *
+ * Every thread draws N_DRAWS from its own engine. Draws are made in batches through a function that is not inlined,
+ * so the state is written back to memory after each batch, as when tasks share an engine array. Engines of 32 bytes
+ * (sfc64, xoshiro256, pcg64) pack two per 64-byte line in an array, so neighbouring threads invalidate each other's
+ * lines; mt19937 (5 KiB) only shares the lines at the ends of its state. Throughput is summed over threads and should
+ * grow with them unless lines are shared.
+ *
+ * On x86_64 MACHINE with 1 core, so threads never run at the same time and the layouts differ only by noise:
+ *                    others::sfc64 packed x1: gmean:      8,133; mean/sd:       8,175/904 us; 515.7 M/s
+ *                    others::sfc64 packed x4: gmean:     37,875; mean/sd:    38,171/4,993 us; 443.0 M/s
+ *              others::sfc64 padded to 64 x4: gmean:     37,821; mean/sd:    38,048/4,455 us; 443.6 M/s
+ *             others::sfc64 padded to 128 x4: gmean:     39,063; mean/sd:    39,469/6,102 us; 429.5 M/s
+ *              others::sfc64 thread_local x4: gmean:     55,352; mean/sd:    55,405/2,574 us; 303.1 M/s
+ *                       PCG::pcg64 packed x4: gmean:     54,750; mean/sd:    54,823/2,969 us; 306.4 M/s
+ *                 PCG::pcg64 padded to 64 x4: gmean:     57,077; mean/sd:    57,207/4,022 us; 293.9 M/s
+ *                     std::mt19937 packed x4: gmean:    187,031; mean/sd:  188,279/23,038 us; 89.7 M/s
+ *               std::mt19937 padded to 64 x4: gmean:    175,548; mean/sd:  176,040/14,095 us; 95.6 M/s
+ */
+#include "arch_utils.hh"
+#include "benchmark_utils.hh"
+#include "vigna.h"
+#include "xoroshiro_wrapper.hh"
+
+#include <pcg_random.hpp>
+#include <sfc.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t NAME_LENGTH = 48;
+constexpr std::size_t N_DRAWS = 1UL << 22;
+constexpr std::size_t BATCH_SIZE = 16;
+constexpr std::size_t N_LAYOUT_REPLICA = 10;
+
+std::atomic<std::uint64_t> sink { 0 };
+
+template <typename Engine> [[gnu::noinline]] std::uint64_t draw_batch(Engine& engine)
+{
+    std::uint64_t sum = 0;
+    for (std::size_t k = 0; k < BATCH_SIZE; k++) {
+        sum += engine();
+    }
+    return sum;
+}
+
+template <typename Engine> std::uint64_t draw_all(Engine& engine)
+{
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < N_DRAWS / BATCH_SIZE; i++) {
+        sum += draw_batch(engine);
+    }
+    return sum;
+}
+
+template <typename Engine, std::size_t ALIGNMENT> struct alignas(ALIGNMENT) PaddedEngine {
+    Engine engine {};
+};
+
+/**
+ * @param run_thread Draws N_DRAWS on thread t of the given number of threads.
+ */
+void bench(const std::string& name, const std::function<void(std::size_t, std::size_t)>& run_thread)
+{
+    for (const std::size_t n_threads : thread_counts()) {
+        std::vector<std::size_t> times {};
+        for (std::size_t j = 0; j < N_LAYOUT_REPLICA; j++) {
+            auto start = std::chrono::high_resolution_clock::now();
+            std::vector<std::thread> workers {};
+            for (std::size_t t = 0; t < n_threads; t++) {
+                workers.emplace_back([&run_thread, t, n_threads]() { run_thread(t, n_threads); });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+        }
+        const double m_draws_per_s
+            = static_cast<double>(N_DRAWS * n_threads) / static_cast<double>(geometric_mean(times));
+        std::cout << std::setw(NAME_LENGTH) << name + " x" + std::to_string(n_threads) + ": " << describe(times)
+                  << " us; " << std::fixed << std::setprecision(1) << m_draws_per_s << " M/s" << std::defaultfloat
+                  << std::endl;
+    }
+}
+
+template <typename Engine> void bench_layouts(const std::string& name)
+{
+    const std::size_t max_threads = thread_counts().back();
+    std::cout << name << ": " << sizeof(Engine) << " bytes" << std::endl;
+
+    const std::unique_ptr<Engine[]> packed { new Engine[max_threads] };
+    bench(name + " packed", [&packed](const std::size_t t, std::size_t /* unused */) { sink += draw_all(packed[t]); });
+
+    const std::unique_ptr<PaddedEngine<Engine, 64>[]> padded_64 { new PaddedEngine<Engine, 64>[max_threads] };
+    bench(name + " padded to 64",
+        [&padded_64](const std::size_t t, std::size_t /* unused */) { sink += draw_all(padded_64[t].engine); });
+
+    const std::unique_ptr<PaddedEngine<Engine, 128>[]> padded_128 { new PaddedEngine<Engine, 128>[max_threads] };
+    bench(name + " padded to 128",
+        [&padded_128](const std::size_t t, std::size_t /* unused */) { sink += draw_all(padded_128[t].engine); });
+
+    bench(name + " thread_local", [](std::size_t /* unused */, std::size_t /* unused */) {
+        static thread_local Engine engine {};
+        sink += draw_all(engine);
+    });
+}
+
+} // namespace
+
+int main()
+{
+    std::cout << "Cache line size assumed by EnginePool: " << BENCH_RAND_CACHE_LINE_SIZE << " bytes" << std::endl;
+    bench_layouts<sfc64>("others::sfc64");
+    bench_layouts<XoroshiroWrapper<old::xoshiro_4x64_plus_plus, uint64_t, 4>>("xoshiro::4x64++");
+    bench_layouts<pcg64>("PCG::pcg64");
+    bench_layouts<std::mt19937>("std::mt19937");
+    std::cout << "(sink: " << sink % 2 << ")" << std::endl;
+    return EXIT_SUCCESS;
+}
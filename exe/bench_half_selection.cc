@@ -0,0 +1,125 @@
+/**
+ * @brief Benchmark feeding 32-bit words from 64-bit engines with fill_u32_halves() against
+ * std::uniform_int_distribution<std::uint32_t>, the path bench_testu01 used for every engine.
+ *
+ * Each method fills N_WORDS words. Whether the distribution keeps the high halves, as fill_u32_halves() with HIGH does,
+ * depends on the standard library and is printed first.
+ *
+ * On x86_64 MACHINE:
+ *    others::sfc64 uniform_int_distribution: gmean:     30,004; mean/sd:      30,010/613 us; 7.15 ns/word
+ *                 others::sfc64 high halves: gmean:     15,340; mean/sd:      15,362/854 us; 3.66 ns/word
+ *                  others::sfc64 low halves: gmean:     15,564; mean/sd:    15,608/1,319 us; 3.71 ns/word
+ *          others::sfc64 interleaved halves: gmean:      9,590; mean/sd:     9,842/2,712 us; 2.29 ns/word
+ *         others::sfc64 bit-reversed halves: gmean:     16,116; mean/sd:    16,185/1,613 us; 3.84 ns/word
+ *   xoshiro::4x64+ uniform_int_distribution: gmean:     30,997; mean/sd:      31,001/519 us; 7.39 ns/word
+ *                xoshiro::4x64+ high halves: gmean:     17,231; mean/sd:      17,235/421 us; 4.11 ns/word
+ *                 xoshiro::4x64+ low halves: gmean:     16,006; mean/sd:    16,277/3,477 us; 3.82 ns/word
+ *         xoshiro::4x64+ interleaved halves: gmean:     12,943; mean/sd:    13,212/2,697 us; 3.09 ns/word
+ *        xoshiro::4x64+ bit-reversed halves: gmean:     19,198; mean/sd:    19,238/1,325 us; 4.58 ns/word
+ *       PCG::pcg64 uniform_int_distribution: gmean:     27,386; mean/sd:    27,589/3,393 us; 6.53 ns/word
+ *                    PCG::pcg64 high halves: gmean:     13,806; mean/sd:      13,821/700 us; 3.29 ns/word
+ *                     PCG::pcg64 low halves: gmean:     13,541; mean/sd:      13,574/984 us; 3.23 ns/word
+ *             PCG::pcg64 interleaved halves: gmean:     10,351; mean/sd:      10,352/147 us; 2.47 ns/word
+ *            PCG::pcg64 bit-reversed halves: gmean:     18,726; mean/sd:      18,736/651 us; 4.46 ns/word
+ *  std::mt19937_64 uniform_int_distribution: gmean:     68,938; mean/sd:    69,145/5,587 us; 16.44 ns/word
+ *               std::mt19937_64 high halves: gmean:     55,100; mean/sd:    55,180/3,121 us; 13.14 ns/word
+ *                std::mt19937_64 low halves: gmean:     55,304; mean/sd:    55,499/4,791 us; 13.19 ns/word
+ *        std::mt19937_64 interleaved halves: gmean:     32,462; mean/sd:    32,477/1,068 us; 7.74 ns/word
+ *       std::mt19937_64 bit-reversed halves: gmean:     40,600; mean/sd:    40,617/1,279 us; 9.68 ns/word
+ */
+#include "benchmark_utils.hh"
+#include "engine_utils.hh"
+#include "rprobs.hh"
+#include "vigna.h"
+#include "xoroshiro_wrapper.hh"
+
+#include <sfc.hpp>
+
+#include <pcg_random.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t NAME_LENGTH = 44;
+constexpr std::size_t N_WORDS = 1UL << 22;
+constexpr std::size_t N_HALVES_REPLICA = 10;
+
+std::uint64_t sink = 0;
+
+void bench(const std::string& name, const std::function<void()>& run_once)
+{
+    std::vector<std::size_t> times {};
+    for (std::size_t j = 0; j < N_HALVES_REPLICA; j++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        run_once();
+        auto end = std::chrono::high_resolution_clock::now();
+        times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+    const double ns_per_word = 1e3 * static_cast<double>(geometric_mean(times)) / static_cast<double>(N_WORDS);
+    std::cout << std::setw(NAME_LENGTH) << name + ": " << describe(times) << " us; " << std::fixed
+              << std::setprecision(2) << ns_per_word << " ns/word" << std::defaultfloat << std::endl;
+}
+
+template <typename Engine> void bench_halves(const std::string& name, Engine& engine)
+{
+    std::vector<std::uint32_t> words(N_WORDS);
+    std::uniform_int_distribution<std::uint32_t> uid { 0, std::numeric_limits<std::uint32_t>::max() };
+    bench(name + " uniform_int_distribution", [&engine, &words, &uid]() {
+        std::generate(words.begin(), words.end(), [&engine, &uid]() { return uid(engine); });
+        sink += words.back();
+    });
+    for (const auto selection :
+        { HalfSelection::HIGH, HalfSelection::LOW, HalfSelection::INTERLEAVED, HalfSelection::BIT_REVERSED }) {
+        bench(name + " " + half_selection_name(selection), [&engine, &words, selection]() {
+            fill_u32_halves(engine, words.data(), words.size(), selection);
+            sink += words.back();
+        });
+    }
+}
+
+bool uid_keeps_high_halves()
+{
+    const std::uint64_t s = seed();
+    sfc64 uid_engine { s };
+    sfc64 halves_engine { s };
+    std::uniform_int_distribution<std::uint32_t> uid { 0, std::numeric_limits<std::uint32_t>::max() };
+    std::vector<std::uint32_t> high(1024);
+    fill_u32_halves(halves_engine, high.data(), high.size(), HalfSelection::HIGH);
+    return std::all_of(high.begin(), high.end(), [&uid, &uid_engine](const std::uint32_t word) {
+        return uid(uid_engine) == word;
+    });
+}
+
+} // namespace
+
+int main()
+{
+    std::cout << "uniform_int_distribution keeps the high halves: " << (uid_keeps_high_halves() ? "yes" : "no")
+              << std::endl;
+
+    sfc64 rng_sfc64 { seed() };
+    bench_halves("others::sfc64", rng_sfc64);
+    XoroshiroWrapper<old::xoshiro_4x64_plus, uint64_t, 4> rng_xoshiro {
+        XoroshiroWrapper<old::xoshiro_4x64_plus, uint64_t, 4>::seeded_state(seed())
+    };
+    bench_halves("xoshiro::4x64+", rng_xoshiro);
+    pcg64 rng_pcg64 { seed() };
+    bench_halves("PCG::pcg64", rng_pcg64);
+    std::mt19937_64 rng_mt19937_64 { seed() };
+    bench_halves("std::mt19937_64", rng_mt19937_64);
+
+    std::cout << "(sink: " << sink % 2 << ")" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,157 @@
+/**
+ * @brief Benchmark constructing and seeding engines, as when an engine is created per task.
+ *
+ * Every replica constructs N_INIT engines, draws one number from each (so construction cannot be elided) and destroys
+ * them. Engines seeded from std::random_device make one system call per word; std::seed_seq mixes every word several
+ * times; SplitMixSeedSeq expands a 64-bit seed with one mix per two words.
+ *
+ * On x86_64 MACHINE (without GSL and MKL):
+ *             std::random_device (one word): gmean:      6,266; mean/sd:       6,297/655 us per 1024 engines
+ *               std::mt19937 (integer seed): gmean:      7,789; mean/sd:       7,799/410 us per 1024 engines
+ *              std::mt19937 (std::seed_seq): gmean:     26,752; mean/sd:    26,814/1,908 us per 1024 engines
+ *            std::mt19937 (SplitMixSeedSeq): gmean:      6,444; mean/sd:       6,499/883 us per 1024 engines
+ *            std::mt19937_64 (integer seed): gmean:      4,168; mean/sd:       4,204/721 us per 1024 engines
+ *           std::mt19937_64 (std::seed_seq): gmean:     25,099; mean/sd:    25,157/1,959 us per 1024 engines
+ *         std::mt19937_64 (SplitMixSeedSeq): gmean:      4,843; mean/sd:       4,854/350 us per 1024 engines
+ *                 PCG::pcg64 (integer seed): gmean:          5; mean/sd:             5/0 us per 1024 engines
+ *                PCG::pcg64 (std::seed_seq): gmean:        598; mean/sd:          600/40 us per 1024 engines
+ *              PCG::pcg64 (SplitMixSeedSeq): gmean:         64; mean/sd:            64/7 us per 1024 engines
+ *        others::arc4_rand32 (integer seed): gmean:      6,211; mean/sd:       6,222/383 us per 1024 engines
+ *       others::arc4_rand32 (std::seed_seq): gmean:      6,459; mean/sd:       6,474/461 us per 1024 engines
+ *     others::arc4_rand32 (SplitMixSeedSeq): gmean:      5,533; mean/sd:       5,555/562 us per 1024 engines
+ *              others::sfc64 (integer seed): gmean:         50; mean/sd:            51/5 us per 1024 engines
+ *      xoshiro::4x64++ (std::random_device): gmean:      6,599; mean/sd:       6,651/893 us per 1024 engines
+ *            xoshiro::4x64++ (seeded_state): gmean:         28; mean/sd:            28/1 us per 1024 engines
+ *   xoroshiro::16x64++ (std::random_device): gmean:     13,669; mean/sd:    13,715/1,288 us per 1024 engines
+ *         xoroshiro::16x64++ (seeded_state): gmean:         79; mean/sd:            79/6 us per 1024 engines
+ *   (sink: 1)
+ */
+#include "bench_rand_conf.hh" // NOLINT
+
+#include "benchmark_utils.hh"
+#include "rprobs.hh"
+#include "seed_utils.hh"
+#include "vigna.h"
+#include "xoroshiro_wrapper.hh"
+
+#include <arc4.hpp>
+#include <sfc.hpp>
+
+#ifdef MKL_FOUND
+#include <mkl.h>
+#endif
+
+#ifdef GSL_FOUND
+#include <gsl/gsl_rng.h>
+#endif
+
+#include <pcg_random.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t NAME_LENGTH = 56;
+constexpr std::size_t N_INIT = 1024;
+
+std::uint64_t sink = 0;
+
+void bench(const std::string& name, const std::function<void(std::uint64_t)>& init_once)
+{
+    std::vector<std::size_t> times {};
+    const std::uint64_t base_seed = seed();
+    for (std::size_t j = 0; j < N_REPLICA; j++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (std::size_t i = 0; i < N_INIT; i++) {
+            init_once(base_seed + i);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+    std::cout << std::setw(NAME_LENGTH) << name + ": " << describe(times) << " us per " << N_INIT << " engines"
+              << std::endl;
+}
+
+template <typename Engine> void bench_std_style(const std::string& name)
+{
+    bench(name + " (integer seed)", [](const std::uint64_t s) {
+        Engine engine { static_cast<typename Engine::result_type>(s) };
+        sink += engine();
+    });
+    bench(name + " (std::seed_seq)", [](const std::uint64_t s) {
+        std::seed_seq seq { static_cast<std::uint32_t>(s), static_cast<std::uint32_t>(s >> 32) };
+        Engine engine { seq };
+        sink += engine();
+    });
+    bench(name + " (SplitMixSeedSeq)", [](const std::uint64_t s) {
+        SplitMixSeedSeq seq { s };
+        Engine engine { seq };
+        sink += engine();
+    });
+}
+
+template <typename Wrapper> void bench_xoroshiro(const std::string& name)
+{
+    bench(name + " (std::random_device)", [](std::uint64_t /* unused */) {
+        Wrapper engine {};
+        sink += engine();
+    });
+    bench(name + " (seeded_state)", [](const std::uint64_t s) {
+        Wrapper engine { Wrapper::seeded_state(s) };
+        sink += engine();
+    });
+}
+
+} // namespace
+
+int main()
+{
+    bench("std::random_device (one word)", [](std::uint64_t /* unused */) {
+        std::random_device rd;
+        sink += rd();
+    });
+    bench_std_style<std::mt19937>("std::mt19937");
+    bench_std_style<std::mt19937_64>("std::mt19937_64");
+    bench_std_style<pcg64>("PCG::pcg64");
+    bench_std_style<arc4_rand32>("others::arc4_rand32");
+    bench("others::sfc64 (integer seed)", [](const std::uint64_t s) {
+        sfc64 engine { s };
+        sink += engine();
+    });
+    bench_xoroshiro<XoroshiroWrapper<old::xoshiro_4x64_plus_plus, uint64_t, 4>>("xoshiro::4x64++");
+    bench_xoroshiro<XoroshiroWrapper<old::xoroshiro_16x64_plus_plus, uint64_t, 16>>("xoroshiro::16x64++");
+#ifdef GSL_FOUND
+    bench("GSL::gsl_rng_alloc+gsl_rng_set (mt19937)", [](const std::uint64_t s) {
+        gsl_rng* r = gsl_rng_alloc(gsl_rng_mt19937);
+        gsl_rng_set(r, s);
+        sink += gsl_rng_get(r);
+        gsl_rng_free(r);
+    });
+#endif
+#ifdef MKL_FOUND
+    for (const auto& [brng, brng_name] : std::vector<std::pair<MKL_INT, std::string>> {
+             { VSL_BRNG_MT19937, "MT19937" }, { VSL_BRNG_SFMT19937, "SFMT19937" },
+             { VSL_BRNG_PHILOX4X32X10, "PHILOX4X32X10" } }) {
+        bench("MKL::vslNewStream (" + brng_name + ")", [brng = brng](const std::uint64_t s) {
+            VSLStreamStatePtr stream = nullptr;
+            vslNewStream(&stream, brng, static_cast<MKL_UINT>(s));
+            unsigned int value = 0;
+            viRngUniformBits(VSL_RNG_METHOD_UNIFORMBITS_STD, stream, 1, &value);
+            sink += value;
+            vslDeleteStream(&stream);
+        });
+    }
+#endif
+    std::cout << "(sink: " << sink % 2 << ")" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+/**
+ * @brief Benchmark the parallel-use patterns of MKL: MT2203 parameter sets, skip-ahead and leapfrog.
+ *
+ * For every pattern, basic generator and number of threads, one MKLStreamFamily of one stream per thread is created
+ * (timed as initialisation), then every thread fills its chunk of one buffer from its own stream with
+ * viRngUniformBits32. Patterns a generator does not support are reported as such.
+ *
+ * Only built when MKL is found.
+ */
+#include "benchmark_utils.hh"
+#include "mkl_rng_wrapper.hh"
+#include "parallel_fill.hh"
+#include "rprobs.hh"
+
+#include <mkl.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t NAME_LENGTH = 56;
+constexpr std::size_t BUFFER_BYTES = 1UL << 26;
+// viRngUniformBits32 takes an MKL_INT count, so large chunks are filled piecewise.
+constexpr std::size_t PIECE_WORDS = 1UL << 16;
+constexpr std::size_t N_MKL_REPLICA = 20;
+
+using Method = MKLStreamFamily::Method;
+
+void bench_family(const std::string& name, const MKL_INT brng, const Method method)
+{
+    std::vector<std::uint32_t> buffer(BUFFER_BYTES / sizeof(std::uint32_t));
+    for (const std::size_t n_threads : thread_counts()) {
+        const std::string label = name + " x" + std::to_string(n_threads);
+        // Skip-ahead blocks as long as the chunks, so the streams continue each other.
+        const auto block_size = static_cast<long long>(buffer.size() / n_threads + 1);
+        std::vector<std::size_t> init_times {};
+        std::vector<std::size_t> fill_times {};
+        try {
+            // A failing fill() throws here rather than on a worker thread, where it would terminate. The probed family
+            // is thrown away, so that the timed streams still continue each other.
+            MKLStreamFamily { brng, method, static_cast<MKL_UINT>(seed()), n_threads, block_size }.fill(
+                0, buffer.data(), 1);
+            for (std::size_t j = 0; j < N_MKL_REPLICA; j++) {
+                auto start = std::chrono::high_resolution_clock::now();
+                const MKLStreamFamily family { brng, method, static_cast<MKL_UINT>(seed()), n_threads, block_size };
+                auto mid = std::chrono::high_resolution_clock::now();
+                parallel_for_chunks(buffer.size(), n_threads,
+                    [&](const std::size_t stream, const std::size_t begin, const std::size_t end) {
+                        for (std::size_t piece = begin; piece < end; piece += PIECE_WORDS) {
+                            family.fill(stream, buffer.data() + piece, std::min(PIECE_WORDS, end - piece));
+                        }
+                    });
+                auto end = std::chrono::high_resolution_clock::now();
+                init_times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count());
+                fill_times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count());
+            }
+        } catch (const std::runtime_error& e) {
+            std::cout << std::setw(NAME_LENGTH) << label + ": " << "unsupported (" << e.what() << ")" << std::endl;
+            return;
+        }
+        const double gb_per_s
+            = static_cast<double>(BUFFER_BYTES) / static_cast<double>(geometric_mean(fill_times)) / 1e3;
+        std::cout << std::setw(NAME_LENGTH) << label + " init: " << describe(init_times) << " us" << std::endl;
+        std::cout << std::setw(NAME_LENGTH) << label + " fill: " << describe(fill_times) << " us; " << std::fixed
+                  << std::setprecision(2) << gb_per_s << " GB/s" << std::defaultfloat << std::endl;
+    }
+}
+
+} // namespace
+
+int main()
+{
+    bench_family("MKL::VSL_BRNG_MT2203 + i", VSL_BRNG_MT2203, Method::MT2203_SET);
+    const std::vector<std::pair<MKL_INT, std::string>> brngs { { VSL_BRNG_MT19937, "MKL::VSL_BRNG_MT19937" },
+        { VSL_BRNG_SFMT19937, "MKL::VSL_BRNG_SFMT19937" }, { VSL_BRNG_PHILOX4X32X10, "MKL::VSL_BRNG_PHILOX4X32X10" },
+        { VSL_BRNG_ARS5, "MKL::VSL_BRNG_ARS5" }, { VSL_BRNG_MCG59, "MKL::VSL_BRNG_MCG59" } };
+    for (const auto& [brng, name] : brngs) {
+        bench_family(name + " skip-ahead", brng, Method::SKIP_AHEAD);
+    }
+    for (const auto& [brng, name] : brngs) {
+        bench_family(name + " leapfrog", brng, Method::LEAPFROG);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,192 @@
+/**
+ * @brief Benchmark the NUMA placement of engine states and output buffers.
+ *
+ * First, one thread bound to node w fills a buffer placed, with its engine, on node m, for every pair of nodes. Then
+ * every thread count fills one buffer per thread, threads being bound to the nodes in turn, either with all engines
+ * and buffers constructed by the main thread bound to the first node, or with each constructed by its own worker
+ * (first touch). Only the fills are timed. Engines are SFMT and std::mt19937, whose kilobytes of state are written at
+ * every refill. The node holding each buffer, as reported by get_mempolicy, is printed to check the placement.
+ *
+ * On x86_64 MACHINE with 1 node and 1 core, so every placement is local and threads only share the core:
+ *   node 0: 1 CPUs
+ *           SFMT node 0, memory 0: gmean:     31,815; mean/sd:    32,210/4,968 us; 0.53 GB/s; buffers on 0
+ *   std::mt19937 node 0, memory 0: gmean:     48,715; mean/sd:    48,826/3,350 us; 0.34 GB/s; buffers on 0
+ *             SFMT main thread x1: gmean:     29,971; mean/sd:    30,484/5,811 us; 0.56 GB/s; buffers on 0
+ *             SFMT main thread x2: gmean:     62,827; mean/sd:   63,554/10,272 us; 0.53 GB/s; buffers on 0,0
+ *             SFMT main thread x4: gmean:    133,113; mean/sd:  137,787/35,726 us; 0.50 GB/s; buffers on 0,0,0,0
+ *     std::mt19937 main thread x1: gmean:     49,200; mean/sd:    49,427/4,880 us; 0.34 GB/s; buffers on 0
+ *     std::mt19937 main thread x2: gmean:    100,774; mean/sd:   101,125/8,527 us; 0.33 GB/s; buffers on 0,0
+ *     std::mt19937 main thread x4: gmean:    197,958; mean/sd:  198,800/17,434 us; 0.34 GB/s; buffers on 0,0,0,0
+ *             SFMT first touch x1: gmean:     38,028; mean/sd:    38,112/2,634 us; 0.44 GB/s; buffers on 0
+ *             SFMT first touch x2: gmean:     57,710; mean/sd:   59,238/14,042 us; 0.58 GB/s; buffers on 0,0
+ *             SFMT first touch x4: gmean:    121,828; mean/sd:  124,599/28,599 us; 0.55 GB/s; buffers on 0,0,0,0
+ *     std::mt19937 first touch x1: gmean:     45,612; mean/sd:    45,642/1,679 us; 0.37 GB/s; buffers on 0
+ *     std::mt19937 first touch x2: gmean:     92,176; mean/sd:    92,221/2,945 us; 0.36 GB/s; buffers on 0,0
+ *     std::mt19937 first touch x4: gmean:    181,159; mean/sd:   181,299/7,358 us; 0.37 GB/s; buffers on 0,0,0,0
+ *   (sink: 1)
+ */
+#include "benchmark_utils.hh"
+#include "numa_utils.hh"
+#include "rprobs.hh"
+#include "sfmt_wrapper.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t NAME_LENGTH = 44;
+constexpr std::size_t BUFFER_WORDS = 1UL << 22;
+constexpr std::size_t N_NUMA_REPLICA = 20;
+
+std::uint64_t sink = 0;
+
+/**
+ * Run @p fn on a new thread bound to @p node and wait for it.
+ */
+void run_on(const NumaNode& node, const std::function<void()>& fn)
+{
+    std::thread worker { [&node, &fn]() {
+        bind_to_cpus(node.cpus);
+        fn();
+    } };
+    worker.join();
+}
+
+struct SFMTFill {
+    using Engine = SFMTBulkRandomDevice;
+    static std::unique_ptr<Engine> make() { return std::make_unique<Engine>(); }
+    static void fill(Engine& engine, std::uint32_t* out, const std::size_t n) { engine.gen(out, n); }
+};
+
+struct MT19937Fill {
+    using Engine = std::mt19937;
+    static std::unique_ptr<Engine> make() { return std::make_unique<Engine>(static_cast<Engine::result_type>(seed())); }
+    static void fill(Engine& engine, std::uint32_t* out, const std::size_t n)
+    {
+        std::generate(out, out + n, [&engine]() { return engine(); });
+    }
+};
+
+/**
+ * Engine and output buffer of one worker, constructed and first touched by the calling thread.
+ */
+template <typename Filler> struct WorkerState {
+    WorkerState()
+        : engine { Filler::make() }
+        // Default-initialised, so the pages are untouched until first_touch().
+        , buffer { new std::uint32_t[BUFFER_WORDS] }
+    {
+        first_touch(buffer.get(), BUFFER_WORDS * sizeof(std::uint32_t));
+    }
+    std::unique_ptr<typename Filler::Engine> engine;
+    std::unique_ptr<std::uint32_t[]> buffer;
+};
+
+void print(const std::string& name, const std::vector<std::size_t>& times, const std::size_t n_bytes,
+    const std::string& placement)
+{
+    const double gb_per_s = static_cast<double>(n_bytes) / static_cast<double>(geometric_mean(times)) / 1e3;
+    std::cout << std::setw(NAME_LENGTH) << name + ": " << describe(times) << " us; " << std::fixed
+              << std::setprecision(2) << gb_per_s << " GB/s" << std::defaultfloat << "; buffers on " << placement
+              << std::endl;
+}
+
+template <typename Filler> void bench_local_remote(const std::string& name, const std::vector<NumaNode>& nodes)
+{
+    for (const auto& memory_node : nodes) {
+        std::unique_ptr<WorkerState<Filler>> state {};
+        run_on(memory_node, [&state]() { state = std::make_unique<WorkerState<Filler>>(); });
+        const std::string placement = std::to_string(node_of(state->buffer.get()));
+        for (const auto& worker_node : nodes) {
+            std::vector<std::size_t> times {};
+            run_on(worker_node, [&state, &times]() {
+                for (std::size_t j = 0; j < N_NUMA_REPLICA; j++) {
+                    auto start = std::chrono::high_resolution_clock::now();
+                    Filler::fill(*state->engine, state->buffer.get(), BUFFER_WORDS);
+                    auto end = std::chrono::high_resolution_clock::now();
+                    times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+                }
+            });
+            sink += state->buffer[BUFFER_WORDS - 1];
+            print(name + " node " + std::to_string(worker_node.id) + ", memory " + std::to_string(memory_node.id),
+                times, BUFFER_WORDS * sizeof(std::uint32_t), placement);
+        }
+    }
+}
+
+template <typename Filler>
+void bench_placement(const std::string& name, const std::vector<NumaNode>& nodes, const bool first_touch_by_worker)
+{
+    for (const std::size_t n_threads : thread_counts()) {
+        std::vector<std::unique_ptr<WorkerState<Filler>>> states(n_threads);
+        if (first_touch_by_worker) {
+            for (std::size_t t = 0; t < n_threads; t++) {
+                run_on(nodes[t % nodes.size()],
+                    [&states, t]() { states[t] = std::make_unique<WorkerState<Filler>>(); });
+            }
+        } else {
+            run_on(nodes.front(), [&states]() {
+                for (auto& state : states) {
+                    state = std::make_unique<WorkerState<Filler>>();
+                }
+            });
+        }
+        std::string placement {};
+        for (const auto& state : states) {
+            placement += (placement.empty() ? "" : ",") + std::to_string(node_of(state->buffer.get()));
+        }
+
+        std::vector<std::size_t> times {};
+        for (std::size_t j = 0; j < N_NUMA_REPLICA; j++) {
+            auto start = std::chrono::high_resolution_clock::now();
+            std::vector<std::thread> workers {};
+            for (std::size_t t = 0; t < n_threads; t++) {
+                workers.emplace_back([&nodes, &states, t]() {
+                    bind_to_cpus(nodes[t % nodes.size()].cpus);
+                    Filler::fill(*states[t]->engine, states[t]->buffer.get(), BUFFER_WORDS);
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+        }
+        for (const auto& state : states) {
+            sink += state->buffer[0];
+        }
+        print(name + (first_touch_by_worker ? " first touch" : " main thread") + " x" + std::to_string(n_threads),
+            times, n_threads * BUFFER_WORDS * sizeof(std::uint32_t), placement);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    const std::vector<NumaNode> nodes = numa_nodes();
+    for (const auto& node : nodes) {
+        std::cout << "node " << node.id << ": " << node.cpus.size() << " CPUs" << std::endl;
+    }
+
+    bench_local_remote<SFMTFill>("SFMT", nodes);
+    bench_local_remote<MT19937Fill>("std::mt19937", nodes);
+    for (const bool first_touch_by_worker : { false, true }) {
+        bench_placement<SFMTFill>("SFMT", nodes, first_touch_by_worker);
+        bench_placement<MT19937Fill>("std::mt19937", nodes, first_touch_by_worker);
+    }
+    std::cout << "(sink: " << sink % 2 << ")" << std::endl;
+    return EXIT_SUCCESS;
+}
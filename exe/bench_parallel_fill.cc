@@ -0,0 +1,156 @@
+/**
+ * @brief Benchmark filling one buffer from several threads.
+ *
+ * First, each thread fills its chunk from its own jumped xoshiro stream. All streams come from one master seed through
+ * XoroshiroStreamFactory, so a run is reproducible for a given number of threads and the chunks never share a
+ * subsequence.
+ *
+ * Then, parallel_fill() and parallel_fill_blocks() fill a larger buffer with one logical stream, so the result does
+ * not depend on the number of threads; this is checked against a single-threaded fill. Parallel std::fill gives the
+ * write bandwidth to compare with. Times include starting and joining the threads, but not making the streams.
+ *
+ * On x86_64 MACHINE with 1 core, so no scaling is expected (64 MiB, then 256 MiB):
+ *                             xoshiro::4x32++ x1: gmean:     69,973; mean/sd:    70,631/9,786 us; 0.96 GB/s
+ *                           xoroshiro::2x64++ x1: gmean:     28,232; mean/sd:    28,350/2,587 us; 2.38 GB/s
+ *                             xoshiro::4x64++ x1: gmean:     44,967; mean/sd:    44,993/1,598 us; 1.49 GB/s
+ *                             xoshiro::4x64++ x4: gmean:     44,202; mean/sd:    44,216/1,185 us; 1.52 GB/s
+ *                          xoroshiro::16x64++ x1: gmean:     39,556; mean/sd:    39,617/2,256 us; 1.70 GB/s
+ *                                   std::fill x1: gmean:     53,367; mean/sd:    53,394/1,751 us; 5.03 GB/s
+ *                  PCG::pcg64 parallel_fill() x1: gmean:    152,331; mean/sd:   152,367/3,386 us; 1.76 GB/s
+ *                  PCG::pcg64 parallel_fill() x4: gmean:    133,342; mean/sd:  134,571/18,669 us; 2.01 GB/s
+ *         others::mcg128_fast parallel_fill() x1: gmean:    145,579; mean/sd:   145,628/3,863 us; 1.84 GB/s
+ *          others::splitmix64 parallel_fill() x1: gmean:    124,757; mean/sd:   124,935/6,805 us; 2.15 GB/s
+ *      xoshiro::4x64++ parallel_fill_blocks() x1: gmean:    170,838; mean/sd:   170,874/3,621 us; 1.57 GB/s
+ *      xoshiro::4x64++ parallel_fill_blocks() x4: gmean:    167,884; mean/sd:   168,108/8,757 us; 1.60 GB/s
+ */
+#include "benchmark_utils.hh"
+#include "parallel_fill.hh"
+#include "rprobs.hh"
+#include "vigna.h"
+#include "xoroshiro_wrapper.hh"
+
+#include <lehmer.hpp>
+#include <pcg_random.hpp>
+#include <splitmix.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t NAME_LENGTH = 48;
+constexpr std::size_t BUFFER_BYTES = 1UL << 26;
+constexpr std::size_t LOGICAL_BUFFER_BYTES = 1UL << 28;
+constexpr std::size_t N_PARALLEL_REPLICA = 20;
+
+using Xoshiro256pp = XoroshiroWrapper<old::xoshiro_4x64_plus_plus, uint64_t, 4>;
+
+void bench(const std::string& name, const std::size_t n_threads, const std::size_t n_bytes,
+    const std::function<void()>& fill_once)
+{
+    std::vector<std::size_t> times {};
+    for (std::size_t j = 0; j < N_PARALLEL_REPLICA; j++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        fill_once();
+        auto end = std::chrono::high_resolution_clock::now();
+        times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+    const double gb_per_s = static_cast<double>(n_bytes) / static_cast<double>(geometric_mean(times)) / 1e3;
+    std::cout << std::setw(NAME_LENGTH) << name + " x" + std::to_string(n_threads) + ": " << describe(times) << " us; "
+              << std::fixed << std::setprecision(2) << gb_per_s << " GB/s" << std::defaultfloat << std::endl;
+}
+
+template <typename Wrapper> void bench_stream_per_thread(const std::string& name)
+{
+    using result_type = typename Wrapper::result_type;
+    std::vector<result_type> buffer(BUFFER_BYTES / sizeof(result_type));
+    const std::uint64_t master_seed = seed();
+
+    for (const std::size_t n_threads : thread_counts()) {
+        // Replicas continue the streams, so that only the fill is timed.
+        XoroshiroStreamFactory<Wrapper> factory { master_seed };
+        auto streams = factory.make_streams(n_threads);
+        bench(name, n_threads, BUFFER_BYTES, [&]() {
+            parallel_for_chunks(
+                buffer.size(), n_threads, [&](const std::size_t chunk, const std::size_t begin, const std::size_t end) {
+                    auto& engine = *streams[chunk];
+                    std::generate(buffer.begin() + static_cast<std::ptrdiff_t>(begin),
+                        buffer.begin() + static_cast<std::ptrdiff_t>(end), [&engine]() { return engine(); });
+                });
+        });
+    }
+}
+
+void bench_write_bandwidth(std::vector<std::uint64_t>& buffer)
+{
+    for (const std::size_t n_threads : thread_counts()) {
+        bench("std::fill", n_threads, LOGICAL_BUFFER_BYTES, [&]() {
+            parallel_for_chunks(buffer.size(), n_threads,
+                [&buffer](std::size_t /* chunk */, const std::size_t begin, const std::size_t end) {
+                    std::fill(buffer.begin() + static_cast<std::ptrdiff_t>(begin),
+                        buffer.begin() + static_cast<std::ptrdiff_t>(end), begin);
+                });
+        });
+    }
+}
+
+template <typename Engine> void bench_logical_stream(const std::string& name, std::vector<std::uint64_t>& buffer)
+{
+    const Engine base { static_cast<typename SubstreamTraits<Engine>::delta_type>(seed()) };
+    std::vector<std::uint64_t> sequential(buffer.size());
+    Engine engine = base;
+    std::generate(sequential.begin(), sequential.end(), [&engine]() { return engine(); });
+
+    bool identical = true;
+    for (const std::size_t n_threads : thread_counts()) {
+        bench(name + " parallel_fill()", n_threads, LOGICAL_BUFFER_BYTES, [&]() {
+            Engine filler = base;
+            parallel_fill(filler, buffer.data(), buffer.size(), n_threads);
+        });
+        identical = identical && buffer == sequential;
+    }
+    std::cout << name << ": " << (identical ? "identical to" : "DIFFERENT from") << " sequential fill" << std::endl;
+}
+
+template <typename Wrapper> void bench_logical_blocks(const std::string& name, std::vector<std::uint64_t>& buffer)
+{
+    const std::uint64_t master_seed = seed();
+    std::vector<std::uint64_t> sequential(buffer.size());
+    parallel_fill_blocks<Wrapper>(master_seed, sequential.data(), sequential.size(), 1);
+
+    bool identical = true;
+    for (const std::size_t n_threads : thread_counts()) {
+        bench(name + " parallel_fill_blocks()", n_threads, LOGICAL_BUFFER_BYTES,
+            [&]() { parallel_fill_blocks<Wrapper>(master_seed, buffer.data(), buffer.size(), n_threads); });
+        identical = identical && buffer == sequential;
+    }
+    std::cout << name << ": " << (identical ? "identical to" : "DIFFERENT from") << " sequential fill" << std::endl;
+}
+
+} // namespace
+
+int main()
+{
+    bench_stream_per_thread<XoroshiroWrapper<old::xoshiro_4x32_plus_plus, uint32_t, 4>>("xoshiro::4x32++");
+    bench_stream_per_thread<XoroshiroWrapper<old::xoroshiro_2x64_plus_plus, uint64_t, 2>>("xoroshiro::2x64++");
+    bench_stream_per_thread<Xoshiro256pp>("xoshiro::4x64++");
+    bench_stream_per_thread<XoroshiroWrapper<old::xoshiro_4x64_star_star, uint64_t, 4>>("xoshiro::4x64**");
+    bench_stream_per_thread<XoroshiroWrapper<old::xoshiro_8x64_plus_plus, uint64_t, 8>>("xoshiro::8x64++");
+    bench_stream_per_thread<XoroshiroWrapper<old::xoroshiro_16x64_plus_plus, uint64_t, 16>>("xoroshiro::16x64++");
+
+    std::vector<std::uint64_t> buffer(LOGICAL_BUFFER_BYTES / sizeof(std::uint64_t));
+    bench_write_bandwidth(buffer);
+    bench_logical_stream<pcg64>("PCG::pcg64", buffer);
+    bench_logical_stream<mcg128_fast>("others::mcg128_fast", buffer);
+    bench_logical_stream<splitmix64>("others::splitmix64", buffer);
+    bench_logical_blocks<Xoshiro256pp>("xoshiro::4x64++", buffer);
+    return EXIT_SUCCESS;
+}
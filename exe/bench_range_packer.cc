@@ -0,0 +1,199 @@
+/**
+ * @brief Benchmark RangePacker on engines whose range is not a full 32-bit word.
+ *
+ * For each engine, N_WORDS 32-bit words are drawn with RangePacker<Engine, std::uint32_t> (packed 32), half as many
+ * 64-bit words with RangePacker<Engine, std::uint64_t> (packed 64), and as many words with
+ * std::uniform_int_distribution<std::uint32_t> (uid), which also combines outputs but draws whole new ones when it
+ * rejects. The engine alone (raw) is timed for as many calls as packed 32 makes. Times and engine calls are given per
+ * 32 bits.
+ *
+ * Before timing, every bit of the packed output of an engine of 3 values and of std::minstd_rand is checked to be set
+ * about half of the time; the exit status reflects the checks.
+ *
+ * On tiny ranges, uid, which multiplies ranges before rejecting, uses fewer calls: RangePacker gets 2/3 of a bit from
+ * each output of ThreeValues against log2(3) for the best packing. Engines with ranges of 24 bits or more lose little.
+ *
+ * On x86_64 MACHINE:
+ *     std::minstd_rand packed 32: gmean:     34,564; mean/sd:    34,643/2,498 us; 32.96 ns, 1.10 calls per 32 bits
+ *     std::minstd_rand packed 64: gmean:     36,126; mean/sd:      36,134/806 us; 34.45 ns, 1.10 calls per 32 bits
+ *           std::minstd_rand uid: gmean:     41,246; mean/sd:    41,437/4,454 us; 39.34 ns, 3.00 calls per 32 bits
+ *           std::minstd_rand raw: gmean:      6,656; mean/sd:       6,657/117 us; 6.35 ns, 1.10 calls per 32 bits
+ *        std::ranlux24 packed 32: gmean:    167,142; mean/sd:  167,883/16,872 us; 159.40 ns, 1.33 calls per 32 bits
+ *        std::ranlux24 packed 64: gmean:    172,240; mean/sd:   172,312/5,245 us; 164.26 ns, 1.33 calls per 32 bits
+ *              std::ranlux24 uid: gmean:    244,206; mean/sd:  244,865/18,729 us; 232.89 ns, 2.00 calls per 32 bits
+ *              std::ranlux24 raw: gmean:    128,557; mean/sd:   128,705/6,467 us; 122.60 ns, 1.33 calls per 32 bits
+ *         std::knuth_b packed 32: gmean:     41,989; mean/sd:    42,051/2,357 us; 40.04 ns, 1.10 calls per 32 bits
+ *         std::knuth_b packed 64: gmean:     37,508; mean/sd:      37,515/769 us; 35.77 ns, 1.10 calls per 32 bits
+ *               std::knuth_b uid: gmean:     54,624; mean/sd:    54,737/3,891 us; 52.09 ns, 3.00 calls per 32 bits
+ *               std::knuth_b raw: gmean:     16,155; mean/sd:      16,160/388 us; 15.41 ns, 1.10 calls per 32 bits
+ *    std::minstd_rand0 packed 32: gmean:     30,130; mean/sd:    30,150/1,151 us; 28.73 ns, 1.10 calls per 32 bits
+ *    std::minstd_rand0 packed 64: gmean:     28,179; mean/sd:    28,200/1,168 us; 26.87 ns, 1.10 calls per 32 bits
+ *          std::minstd_rand0 uid: gmean:     35,601; mean/sd:    35,626/1,453 us; 33.95 ns, 3.00 calls per 32 bits
+ *          std::minstd_rand0 raw: gmean:      6,723; mean/sd:       6,724/125 us; 6.41 ns, 1.10 calls per 32 bits
+ *          ThreeValues packed 32: gmean:    717,523; mean/sd:  720,058/63,383 us; 684.28 ns, 48.00 calls per 32 bits
+ *          ThreeValues packed 64: gmean:    705,619; mean/sd:  708,098/63,099 us; 672.93 ns, 48.00 calls per 32 bits
+ *                ThreeValues uid: gmean:    380,217; mean/sd:  380,418/12,835 us; 362.60 ns, 23.25 calls per 32 bits
+ *                ThreeValues raw: gmean:    185,830; mean/sd:  186,556/17,818 us; 177.22 ns, 48.00 calls per 32 bits
+ */
+#include "benchmark_utils.hh"
+#include "range_packer.hh"
+#include "rprobs.hh"
+
+#include <splitmix.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t NAME_LENGTH = 32;
+constexpr std::size_t N_WORDS = 1UL << 20;
+constexpr std::size_t N_CHECK_WORDS = 1UL << 20;
+constexpr std::size_t N_PACKER_REPLICA = 10;
+
+std::uint64_t sink = 0;
+
+/**
+ * Engine forwarding to @p Engine and counting its calls.
+ */
+template <typename Engine> struct CountingEngine {
+    using result_type = typename Engine::result_type;
+
+    Engine& engine;
+    std::size_t n_calls = 0;
+
+    result_type operator()()
+    {
+        n_calls++;
+        return engine();
+    }
+    // Static, as std::uniform_int_distribution checks the range at compile time.
+    static constexpr result_type min() { return Engine::min(); }
+    static constexpr result_type max() { return Engine::max(); }
+};
+
+/**
+ * Engine of the 3 values 0, 1 and 2, the smallest range that is not a power of 2.
+ */
+struct ThreeValues {
+    using result_type = std::uint32_t;
+
+    splitmix64 engine { seed() };
+
+    result_type operator()() { return static_cast<result_type>(engine() % 3); }
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 2; }
+};
+
+void print(const std::string& name, const std::vector<std::size_t>& times, const double calls_per_word)
+{
+    const double ns_per_word = 1e3 * static_cast<double>(geometric_mean(times)) / static_cast<double>(N_WORDS);
+    std::cout << std::setw(NAME_LENGTH) << name + ": " << describe(times) << " us; " << std::fixed
+              << std::setprecision(2) << ns_per_word << " ns, " << calls_per_word << " calls per 32 bits"
+              << std::defaultfloat << std::endl;
+}
+
+std::vector<std::size_t> time_replicas(const std::function<void()>& run_once)
+{
+    std::vector<std::size_t> times {};
+    for (std::size_t j = 0; j < N_PACKER_REPLICA; j++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        run_once();
+        auto end = std::chrono::high_resolution_clock::now();
+        times.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+    return times;
+}
+
+/**
+ * @return Whether every bit of N_CHECK_WORDS packed words is set within 5 standard deviations of half the time.
+ */
+template <typename Engine> bool check_bits(Engine& engine)
+{
+    RangePacker<Engine> packer { engine };
+    std::array<std::size_t, 32> n_set {};
+    for (std::size_t i = 0; i < N_CHECK_WORDS; i++) {
+        const std::uint32_t word = packer();
+        for (std::size_t bit = 0; bit < n_set.size(); bit++) {
+            n_set[bit] += (word >> bit) & 1U;
+        }
+    }
+    const double tolerance = 5 * std::sqrt(static_cast<double>(N_CHECK_WORDS) / 4);
+    return std::all_of(n_set.begin(), n_set.end(), [tolerance](const std::size_t n) {
+        return std::abs(static_cast<double>(n) - static_cast<double>(N_CHECK_WORDS) / 2) < tolerance;
+    });
+}
+
+template <typename Engine> void bench_packer(const std::string& name, Engine& engine)
+{
+    CountingEngine<Engine> counting { engine };
+    std::vector<std::uint32_t> words(N_WORDS);
+    std::vector<std::uint64_t> wide_words(N_WORDS / 2);
+
+    RangePacker<CountingEngine<Engine>, std::uint32_t> packer { counting };
+    const auto packed_times = time_replicas([&packer, &words]() {
+        packer.fill(words.data(), words.size());
+        sink += words.back();
+    });
+    const std::size_t n_packed_calls = counting.n_calls / N_PACKER_REPLICA;
+    print(name + " packed 32", packed_times, static_cast<double>(n_packed_calls) / N_WORDS);
+
+    counting.n_calls = 0;
+    RangePacker<CountingEngine<Engine>, std::uint64_t> wide_packer { counting };
+    const auto wide_times = time_replicas([&wide_packer, &wide_words]() {
+        wide_packer.fill(wide_words.data(), wide_words.size());
+        sink += wide_words.back();
+    });
+    print(name + " packed 64", wide_times,
+        static_cast<double>(counting.n_calls / N_PACKER_REPLICA) / N_WORDS);
+
+    counting.n_calls = 0;
+    std::uniform_int_distribution<std::uint32_t> uid { 0, std::numeric_limits<std::uint32_t>::max() };
+    const auto uid_times = time_replicas([&uid, &counting, &words]() {
+        std::generate(words.begin(), words.end(), [&uid, &counting]() { return uid(counting); });
+        sink += words.back();
+    });
+    print(name + " uid", uid_times,
+        static_cast<double>(counting.n_calls / N_PACKER_REPLICA) / N_WORDS);
+
+    const auto raw_times = time_replicas([&engine, n_packed_calls]() {
+        for (std::size_t i = 0; i < n_packed_calls; i++) {
+            sink += engine();
+        }
+    });
+    print(name + " raw", raw_times, static_cast<double>(n_packed_calls) / N_WORDS);
+}
+
+} // namespace
+
+int main()
+{
+    ThreeValues three_values {};
+    std::minstd_rand check_minstd { static_cast<std::minstd_rand::result_type>(seed()) };
+    const bool ok = check_bits(three_values) && check_bits(check_minstd);
+    std::cout << "Packed bits balanced: " << (ok ? "OK" : "FAILED") << std::endl;
+
+    std::minstd_rand minstd { static_cast<std::minstd_rand::result_type>(seed()) };
+    bench_packer("std::minstd_rand", minstd);
+    std::ranlux24 ranlux24 { static_cast<std::ranlux24::result_type>(seed()) };
+    bench_packer("std::ranlux24", ranlux24);
+    std::knuth_b knuth_b { static_cast<std::knuth_b::result_type>(seed()) };
+    bench_packer("std::knuth_b", knuth_b);
+    std::minstd_rand0 minstd0 { static_cast<std::minstd_rand0::result_type>(seed()) };
+    bench_packer("std::minstd_rand0", minstd0);
+    bench_packer("ThreeValues", three_values);
+
+    std::cout << "(sink: " << sink % 2 << ")" << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
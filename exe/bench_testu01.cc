@@ -1,6 +1,13 @@
+#include "block_scheduler.hh"
 #include "class_utils.hh"
+#include "engine_utils.hh"
 #include "gsl_rng_wrapper.hh"
+#include "range_packer.hh"
 #include "rprobs.hh"
+#include "shm_ring.h"
+#include "stream_interleaver.hh"
+#include "testu01_batteries.h"
+#include "testu01_results.hh"
 #include "vigna.h"
 #include "xoroshiro_wrapper.hh"
 
@@ -14,20 +21,38 @@
 #include <mkl.h>
 
 #include <gsl/gsl_rng.h>
+#include <gsl/gsl_version.h>
 
 #include <boost/filesystem.hpp>
 #include <boost/process.hpp>
+#include <boost/process/extend.hpp>
 #include <boost/random.hpp>
 
 #include <absl/random/random.h>
 
 #include <pcg_random.hpp>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <exception>
 #include <fstream>
+#include <functional>
+#include <memory>
 #include <random>
+#include <string>
+#include <system_error>
+#include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -35,36 +60,98 @@ static std::string testu01_path;
 
 namespace bp = boost::process;
 
+/**
+ * Battery to run, or only its test number test if positive; see testu01_batteries.h.
+ */
+struct BatteryOptions {
+    std::string battery = "SmallCrush";
+    int test = 0;
+    double n_bits = TESTU01_DEFAULT_N_BITS;
+
+    [[nodiscard]] std::string label() const { return test > 0 ? battery + " test " + std::to_string(test) : battery; }
+};
+
+/**
+ * Producer side of the shared-memory ring of shm_ring.h, which testu01_main reads with --ring.
+ *
+ * The ring lives in a memfd, whose number the child gets on the command line. It is close-on-exec, so that children
+ * of concurrent jobs do not inherit it, and only the child of this writer clears the flag with child_setup(). Words are
+ * generated in place, which saves the copies into and out of a pipe and the system call per write.
+ */
 class ContinuousDataWriter {
 
 public:
-    ContinuousDataWriter(bp::async_pipe& pipe, bp::child& proc)
-        : stdin_pipe_(pipe)
-        , process_(proc)
+    explicit ContinuousDataWriter(const std::uint32_t capacity = RING_CAPACITY)
+        : fd_(memfd_create("testu01_ring", MFD_CLOEXEC))
+        , size_(shm_ring_size(capacity))
+    {
+        if (fd_ < 0 || ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+            const int error = errno;
+            if (fd_ >= 0) {
+                close(fd_);
+            }
+            throw std::system_error(error, std::generic_category(), "Failed to create the ring buffer");
+        }
+        void* mapping = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (mapping == MAP_FAILED) {
+            const int error = errno;
+            close(fd_);
+            throw std::system_error(error, std::generic_category(), "Failed to map the ring buffer");
+        }
+        ring_ = static_cast<shm_ring*>(mapping);
+        ring_->capacity = capacity;
+    }
+    ~ContinuousDataWriter()
     {
+        munmap(ring_, size_);
+        close(fd_);
     }
-    ~ContinuousDataWriter() { stop(); }
     DELETE_COPY_MOVE(ContinuousDataWriter)
 
-    void write(const char* data_to_send = nullptr, std::size_t size = 0)
+    [[nodiscard]] int fd() const { return fd_; }
+
+    /**
+     * Property of bp::child that lets the child keep the ring across exec.
+     */
+    [[nodiscard]] auto child_setup() const
+    {
+        return bp::extend::on_exec_setup([fd = fd_](auto& /* executor */) { fcntl(fd, F_SETFD, 0); });
+    }
+
+    /**
+     * Generate words into the ring with @p fill(out, n) until @p process exits.
+     */
+    void feed(bp::child& process, const std::function<void(std::uint32_t*, std::size_t)>& fill)
     {
-        if (good()) {
-            try {
-                actual_bytes_transferred_ += boost::asio::write(stdin_pipe_, boost::asio::buffer(data_to_send, size));
-            } catch (const std::exception& e) {
-                // std::cerr << "Write error: " << e.what() << std::endl;
-                stop();
+        const std::uint32_t capacity = ring_->capacity;
+        std::uint32_t* data = shm_ring_data(ring_);
+        std::uint32_t head = ring_->head;
+        std::uint32_t tail = __atomic_load_n(&ring_->tail, __ATOMIC_ACQUIRE);
+        while (process.running()) {
+            const std::uint32_t n_free = capacity - (head - tail);
+            if (n_free == 0) {
+                tail = shm_ring_await_change(&ring_->tail, tail, &ring_->producer_waiting);
+                continue;
             }
+            const std::uint32_t offset = head & (capacity - 1);
+            const std::uint32_t n = std::min({ n_free, capacity - offset, FILL_WORDS });
+            fill(data + offset, n);
+            head += n;
+            shm_ring_publish(&ring_->head, head, &ring_->consumer_waiting);
+            actual_bytes_transferred_ += n * sizeof(std::uint32_t);
+            tail = __atomic_load_n(&ring_->tail, __ATOMIC_ACQUIRE);
         }
+        __atomic_store_n(&ring_->closed, 1, __ATOMIC_RELEASE);
     }
-    void stop() { should_continue_ = false; }
     [[nodiscard]] std::size_t actual_bytes_transferred() const { return actual_bytes_transferred_; }
-    [[nodiscard]] bool good() const { return should_continue_ && process_.running() && stdin_pipe_.is_open(); }
 
 private:
-    bp::async_pipe& stdin_pipe_;
-    bool should_continue_ = true;
-    bp::child& process_;
+    static constexpr std::uint32_t RING_CAPACITY = 1U << 22;
+    static constexpr std::uint32_t FILL_WORDS = 1U << 16;
+
+    int fd_;
+    std::size_t size_;
+    shm_ring* ring_ = nullptr;
     std::size_t actual_bytes_transferred_ = 0;
 };
 
@@ -79,105 +166,214 @@ public:
     }
     virtual ~BenchmarkingHelper() = default;
     DELETE_COPY_MOVE(BenchmarkingHelper)
-    void run()
+
+    /**
+     * Run a battery on the output of the generator, either in testu01_main fed through a shared-memory ring, which
+     * survives crashes of TestU01, or in this process through unif01_CreateExternGenBits, which needs no transfer.
+     * Several helpers may run at once in subprocesses, so nothing is written to the results here.
+     *
+     * @return The section of testu01_results.txt for this generator.
+     */
+    std::string run(const BatteryOptions& options, const bool in_process)
     {
-        std::ofstream f { "testu01_results.txt", std::ios::app };
+        std::string section = ">" + name_ + " [" + options.label() + "]\n";
+        const auto range = this->range();
+        log("Ranged " + formatWithCommas(range) + ".");
+        if (range < std::numeric_limits<std::uint32_t>::max()) {
+            log("Range too small, skipping; register it with bench_bits_packed.");
+            return section + "Range too small, skipping.\n";
+        }
+        return section + (in_process ? run_in_process(options) : run_subprocess(options));
+    }
+
+    /**
+     * Fill @p out[0, @p n) with the next 32-bit words of the generator.
+     */
+    virtual void fill(std::uint32_t* out, std::size_t n) = 0;
+    virtual std::size_t range() = 0;
 
-        f << ">" << name_ << "\n";
+protected:
+    // One insertion per line, so that lines of concurrent jobs do not interleave.
+    void log(const std::string& message) const { std::cerr << name_ + ": " + message + "\n"; }
 
+private:
+    static constexpr std::size_t IN_PROCESS_BUFFER_WORDS = 1UL << 20;
+
+    std::string run_subprocess(const BatteryOptions& options)
+    {
+        ContinuousDataWriter cdw {};
         boost::asio::io_context io_context;
-        bp::async_pipe stdin_pipe { io_context };
         std::future<std::string> stdout_buffer;
-        // Create the child process
-        bp::child c(
-            testu01_path, bp::std_in<stdin_pipe, bp::std_out> stdout_buffer, bp::std_err > bp::null, io_context);
-        const auto range = this->range();
-        std::cerr << name_ << ": Ranged " << formatWithCommas(range) << "." << std::endl;
-        if (range < std::numeric_limits<std::uint32_t>::max()) {
-            std::cerr << name_ << ": Range too small, skipping." << std::endl;
-            f << "Range too small, skipping.\n";
-            f.close();
-            return;
-        }
-        std::cerr << name_ << ": Subprocess started." << std::endl;
+        std::vector<std::string> args { "--ring", std::to_string(cdw.fd()), "--battery", options.battery, "--test",
+            std::to_string(options.test), "--bits", std::to_string(options.n_bits) };
+        // Boost creates the stdout pipe without close-on-exec, so a child forked by another job while the write end is
+        // open would keep it, and this job would wait for that child to exit. Spawns are therefore serialized.
+        std::unique_lock<std::mutex> spawn_lock { spawn_mutex_ };
+        bp::child c(testu01_path, bp::args(args), bp::std_in<bp::null, bp::std_out> stdout_buffer,
+            bp::std_err > bp::null, io_context, cdw.child_setup());
+        spawn_lock.unlock();
+        log("Subprocess started.");
 
-        ContinuousDataWriter cdw { stdin_pipe, c };
         std::thread io_thread([&io_context]() { io_context.run(); });
-        auto rand_bytes_adaptor_thread = create_rand_bytes_adaptor_thread(cdw);
-        rand_bytes_adaptor_thread.join();
-        stdin_pipe.close();
+        cdw.feed(c, [this](std::uint32_t* out, const std::size_t n) { fill(out, n); });
         c.wait();
         io_thread.join();
-        auto stdout_contents = stdout_buffer.get();
-        f.write(stdout_contents.c_str(), stdout_contents.size());
-        f.close();
 
-        std::cerr << name_ << ": Subprocess finished with " << formatWithCommas(cdw.actual_bytes_transferred())
-                  << " bytes." << std::endl;
+        log("Subprocess finished with " + formatWithCommas(cdw.actual_bytes_transferred()) + " bytes.");
+        return stdout_buffer.get();
     }
 
-    virtual std::thread create_rand_bytes_adaptor_thread(ContinuousDataWriter& cdw) = 0;
-    virtual std::size_t range() = 0;
+    std::string run_in_process(const BatteryOptions& options)
+    {
+        in_process_helper_ = this;
+        in_process_buffer_.resize(IN_PROCESS_BUFFER_WORDS);
+        in_process_position_ = in_process_buffer_.size();
+        in_process_refills_ = 0;
+        std::string gen_name = name_;
+        unif01_Gen* gen = unif01_CreateExternGenBits(gen_name.data(), in_process_bits);
+        std::string output = capture_stdout([gen, &options]() {
+            swrite_Basic = FALSE;
+            testu01_run_battery(gen, options.battery.c_str(), options.test, options.n_bits);
+        });
+        unif01_DeleteExternGenBits(gen);
+        in_process_helper_ = nullptr;
+
+        log("In-process run finished with "
+            + formatWithCommas(in_process_refills_ * IN_PROCESS_BUFFER_WORDS * sizeof(std::uint32_t)) + " bytes.");
+        return output;
+    }
+
+    static unsigned int in_process_bits()
+    {
+        if (in_process_position_ == in_process_buffer_.size()) {
+            in_process_helper_->fill(in_process_buffer_.data(), in_process_buffer_.size());
+            in_process_position_ = 0;
+            in_process_refills_++;
+        }
+        return in_process_buffer_[in_process_position_++];
+    }
+
+    /**
+     * Call @p fn with the standard output, where TestU01 prints its reports, redirected to a temporary file.
+     *
+     * @return What @p fn printed.
+     */
+    static std::string capture_stdout(const std::function<void()>& fn)
+    {
+        std::unique_ptr<std::FILE, decltype(&std::fclose)> capture { std::tmpfile(), &std::fclose };
+        if (capture == nullptr) {
+            throw std::system_error(errno, std::generic_category(), "Failed to create a temporary file");
+        }
+        std::fflush(stdout);
+        const int saved_stdout = dup(STDOUT_FILENO);
+        dup2(fileno(capture.get()), STDOUT_FILENO);
+        fn();
+        std::fflush(stdout);
+        dup2(saved_stdout, STDOUT_FILENO);
+        close(saved_stdout);
+
+        std::rewind(capture.get());
+        std::string output {};
+        std::array<char, 4096> chunk {};
+        std::size_t n_read = 0;
+        while ((n_read = std::fread(chunk.data(), 1, chunk.size(), capture.get())) > 0) {
+            output.append(chunk.data(), n_read);
+        }
+        return output;
+    }
+
+    inline static std::mutex spawn_mutex_;
+    // TestU01 takes a plain function without context and allows one external generator at a time, so in-process runs
+    // go one after another through these.
+    inline static BenchmarkingHelper* in_process_helper_ = nullptr;
+    inline static std::vector<std::uint32_t> in_process_buffer_ {};
+    inline static std::size_t in_process_position_ = 0;
+    inline static std::size_t in_process_refills_ = 0;
 };
 
-template <typename T, typename N = std::uint32_t> class StlBenchmarkingHelper : public BenchmarkingHelper {
+template <typename T> class StlBenchmarkingHelper : public BenchmarkingHelper {
 private:
-    T& rng_;
+    std::unique_ptr<T> rng_;
+    std::uniform_int_distribution<std::uint32_t> uid_ { 0, std::numeric_limits<std::uint32_t>::max() };
 
 public:
-    StlBenchmarkingHelper(T& rng, std::string name_)
+    StlBenchmarkingHelper(std::unique_ptr<T> rng, std::string name_)
         : BenchmarkingHelper(std::move(name_))
-        , rng_(rng)
+        , rng_(std::move(rng))
     {
     }
     ~StlBenchmarkingHelper() override = default;
     DELETE_COPY_MOVE(StlBenchmarkingHelper)
-    std::thread create_rand_bytes_adaptor_thread(ContinuousDataWriter& cdw) override
+
+    void fill(std::uint32_t* out, const std::size_t n) override
     {
-        return std::thread([&cdw, this]() { rand_bytes_adaptor(cdw); });
+        std::generate_n(out, n, [this]() { return uid_(*rng_); });
     }
+    std::size_t range() override { return static_cast<std::size_t>(rng_->max() - rng_->min()); }
+};
+
+/**
+ * Helper for engines whose range is not a full 32-bit word, whose outputs are packed into words by RangePacker.
+ */
+template <typename T> class PackedBenchmarkingHelper : public BenchmarkingHelper {
+private:
+    std::unique_ptr<T> rng_;
+    RangePacker<T> packer_;
 
-    void rand_bytes_adaptor(ContinuousDataWriter& cdw)
+public:
+    PackedBenchmarkingHelper(std::unique_ptr<T> rng, std::string name_)
+        : BenchmarkingHelper(std::move(name_))
+        , rng_(std::move(rng))
+        , packer_(*rng_)
     {
-        auto uid = std::uniform_int_distribution<N>(0, std::numeric_limits<N>::max());
-        std::vector<N> buffer {};
-        buffer.resize(4096);
-        while (cdw.good()) {
-            std::generate_n(buffer.begin(), buffer.size(), [&uid, this]() { return uid(rng_); });
-            cdw.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(N));
-        }
     }
-    std::size_t range() override { return static_cast<std::size_t>(rng_.max() - rng_.min()); }
+    ~PackedBenchmarkingHelper() override = default;
+    DELETE_COPY_MOVE(PackedBenchmarkingHelper)
+
+    void fill(std::uint32_t* out, const std::size_t n) override { packer_.fill(out, n); }
+    std::size_t range() override { return std::numeric_limits<std::uint32_t>::max(); }
+};
+
+/**
+ * Helper for 64-bit engines, whose outputs are split into 32-bit words by fill_u32_halves() without a distribution.
+ */
+template <typename T> class HalvesBenchmarkingHelper : public BenchmarkingHelper {
+private:
+    std::unique_ptr<T> rng_;
+    HalfSelection selection_;
+
+public:
+    HalvesBenchmarkingHelper(std::unique_ptr<T> rng, const HalfSelection selection, std::string name_)
+        : BenchmarkingHelper(std::move(name_))
+        , rng_(std::move(rng))
+        , selection_(selection)
+    {
+    }
+    ~HalvesBenchmarkingHelper() override = default;
+    DELETE_COPY_MOVE(HalvesBenchmarkingHelper)
+
+    void fill(std::uint32_t* out, const std::size_t n) override { fill_u32_halves(*rng_, out, n, selection_); }
+    std::size_t range() override { return static_cast<std::size_t>(rng_->max() - rng_->min()); }
 };
 
-template <typename N = std::uint32_t> class MklBenchmarkingHelper : public BenchmarkingHelper {
+class MklBenchmarkingHelper : public BenchmarkingHelper {
 private:
     VSLStreamStatePtr stream_ = nullptr;
     MKL_INT type_;
 
 public:
-    MklBenchmarkingHelper(const MKL_INT type, std::string name_)
+    MklBenchmarkingHelper(const MKL_INT type, std::string name_, const std::uint64_t job_seed)
         : BenchmarkingHelper(std::move(name_))
         , type_(type)
     {
-        vslNewStream(&stream_, type_, seed());
+        vslNewStream(&stream_, type_, job_seed);
     }
     ~MklBenchmarkingHelper() override { vslDeleteStream(&stream_); };
     DELETE_COPY_MOVE(MklBenchmarkingHelper)
-    std::thread create_rand_bytes_adaptor_thread(ContinuousDataWriter& cdw) override
-    {
-        return std::thread([&cdw, this]() { rand_bytes_adaptor(cdw); });
-    }
 
-    void rand_bytes_adaptor(ContinuousDataWriter& cdw)
+    void fill(std::uint32_t* out, const std::size_t n) override
     {
-        auto uid = std::uniform_int_distribution<N>(0, std::numeric_limits<N>::max());
-        std::vector<N> buffer {};
-        buffer.resize(4096);
-        while (cdw.good()) {
-            viRngUniformBits32(VSL_RNG_METHOD_UNIFORMBITS32_STD, stream_, buffer.size(), buffer.data());
-            cdw.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(N));
-        }
+        viRngUniformBits32(VSL_RNG_METHOD_UNIFORMBITS32_STD, stream_, static_cast<MKL_INT>(n), out);
     }
     std::size_t range() override
     {
@@ -187,76 +383,337 @@ public:
     }
 };
 
-template <typename N = std::uint32_t> class GslBenchmarkingHelper : public BenchmarkingHelper {
+class GslBenchmarkingHelper : public BenchmarkingHelper {
 private:
     gsl_rng* gen_;
 
 public:
-    GslBenchmarkingHelper(const gsl_rng_type* type, std::string name_)
+    GslBenchmarkingHelper(const gsl_rng_type* type, std::string name_, const std::uint64_t job_seed)
         : BenchmarkingHelper(std::move(name_))
         , gen_(gsl_rng_alloc(type))
     {
-        gsl_rng_set(gen_, seed());
+        gsl_rng_set(gen_, job_seed);
     }
     ~GslBenchmarkingHelper() override { gsl_rng_free(gen_); }
     DELETE_COPY_MOVE(GslBenchmarkingHelper)
-    std::thread create_rand_bytes_adaptor_thread(ContinuousDataWriter& cdw) override
-    {
-        return std::thread([&cdw, this]() { rand_bytes_adaptor(cdw); });
-    }
 
-    void rand_bytes_adaptor(ContinuousDataWriter& cdw)
+    void fill(std::uint32_t* out, const std::size_t n) override
     {
-        std::vector<N> buffer {};
-        buffer.resize(4096);
-        while (cdw.good()) {
-            std::generate_n(buffer.begin(), buffer.size(),
-                [this]() { return gsl_rng_uniform_int(gen_, std::numeric_limits<N>::max()); });
-
-            cdw.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(N));
-        }
+        std::generate_n(
+            out, n, [this]() { return gsl_rng_uniform_int(gen_, std::numeric_limits<std::uint32_t>::max()); });
     }
     std::size_t range() override { return static_cast<std::size_t>(gsl_rng_max(gen_) - gsl_rng_min(gen_)); }
 };
 
 namespace {
 
-template <typename T> void bench_bits_stl(T& rng, const std::string& name)
+const std::string RESULTS_PATH = "testu01_results.txt";
+const std::string RESULTS_STORE_PATH = "testu01_results.csv";
+
+/**
+ * One generator to test, on the whole battery or on one of its tests. Jobs are registered by the *_main() functions,
+ * then run concurrently; each constructs its generator from its seed on the thread that runs it.
+ */
+struct TestU01Job {
+    std::string name;
+    std::uint64_t job_seed;
+    std::function<std::unique_ptr<BenchmarkingHelper>(const std::string&, std::uint64_t)> make_helper;
+    int test = 0;
+    /** Version of the library of the generator and how its output becomes 32-bit words, for the result store. */
+    std::string version;
+    std::string adaptor;
+};
+
+std::vector<TestU01Job> registry;
+// Seed of the whole run; the seed of each generator is derived from it and the name of the generator, so that a rerun
+// with the same seed finds its results in the store even if generators were added or removed.
+std::uint64_t master_seed = 1;
+// Version of the generators being registered, set by each *_main().
+std::string library_version;
+// Number of streams interleaved by the jobs of streams_main().
+std::size_t n_interleaved_streams = 4;
+
+/**
+ * @return A seed for generator @p name, from FNV-1a of the name mixed with the master seed.
+ */
+std::uint64_t job_seed_of(const std::string& name)
+{
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const char c : name) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+    }
+    return splitmix64 { master_seed ^ hash }();
+}
+
+void register_job(const std::string& name, const std::string& adaptor,
+    std::function<std::unique_ptr<BenchmarkingHelper>(const std::string&, std::uint64_t)> make_helper)
+{
+    registry.push_back({ name, job_seed_of(name), std::move(make_helper), 0, library_version, adaptor });
+}
+
+/**
+ * Replace every job by one job per test of the battery, in test order. Each test is fed by its own stream, seeded with
+ * consecutive SplitMix64 outputs from the seed of the generator, so the tests of one generator can run in parallel.
+ */
+void split_registry(const int n_tests)
+{
+    std::vector<TestU01Job> split {};
+    for (const auto& job : registry) {
+        splitmix64 test_seeds { job.job_seed };
+        for (int test = 1; test <= n_tests; test++) {
+            split.push_back({ job.name, test_seeds(), job.make_helper, test, job.version, job.adaptor });
+        }
+    }
+    registry = std::move(split);
+}
+
+/**
+ * Register a generator constructed by @p make_engine from the seed of the job.
+ */
+template <typename T>
+void bench_bits_stl(const std::string& name, std::function<std::unique_ptr<T>(std::uint64_t)> make_engine)
+{
+    register_job(name, "uniform_int_distribution<uint32_t>",
+        [make_engine = std::move(make_engine)](const std::string& job_name, const std::uint64_t s) {
+            return std::make_unique<StlBenchmarkingHelper<T>>(make_engine(s), job_name);
+        });
+}
+
+/**
+ * Register a generator seeded with the seed of the job cast to its result_type.
+ */
+template <typename T> void bench_bits_stl(const std::string& name)
+{
+    bench_bits_stl<T>(
+        name, [](const std::uint64_t s) { return std::make_unique<T>(static_cast<typename T::result_type>(s)); });
+}
+
+/**
+ * Register a generator whose range is not a full 32-bit word, constructed by @p make_engine from the seed of the job
+ * and packed by RangePacker.
+ */
+template <typename T>
+void bench_bits_packed(const std::string& name, std::function<std::unique_ptr<T>(std::uint64_t)> make_engine)
+{
+    register_job(name, "RangePacker<uint32_t>",
+        [make_engine = std::move(make_engine)](const std::string& job_name, const std::uint64_t s) {
+            return std::make_unique<PackedBenchmarkingHelper<T>>(make_engine(s), job_name);
+        });
+}
+
+template <typename T> void bench_bits_packed(const std::string& name)
+{
+    bench_bits_packed<T>(
+        name, [](const std::uint64_t s) { return std::make_unique<T>(static_cast<typename T::result_type>(s)); });
+}
+
+/**
+ * Register a 64-bit generator constructed by @p make_engine from the seed of the job once per HalfSelection, so that
+ * weaknesses of its low bits are tested too. All selections of one generator share its seed.
+ */
+template <typename T>
+void bench_bits_halves(const std::string& name, const std::function<std::unique_ptr<T>(std::uint64_t)>& make_engine)
+{
+    static_assert(std::numeric_limits<typename T::result_type>::digits == 64, "Halves of 64-bit outputs only.");
+    for (const auto selection :
+        { HalfSelection::HIGH, HalfSelection::LOW, HalfSelection::INTERLEAVED, HalfSelection::BIT_REVERSED }) {
+        register_job(name, half_selection_name(selection),
+            [make_engine, selection](const std::string& job_name, const std::uint64_t s) {
+                return std::make_unique<HalvesBenchmarkingHelper<T>>(make_engine(s), selection, job_name);
+            });
+    }
+}
+
+template <typename T> void bench_bits_halves(const std::string& name)
 {
-    StlBenchmarkingHelper { rng, name }.run();
+    bench_bits_halves<T>(
+        name, [](const std::uint64_t s) { return std::make_unique<T>(static_cast<typename T::result_type>(s)); });
+}
+
+/**
+ * Register a xoshiro/xoroshiro generator whose state is expanded from the seed of the job.
+ */
+template <typename T> void bench_bits_xso(const std::string& name)
+{
+    bench_bits_stl<T>(name, [](const std::uint64_t s) { return std::make_unique<T>(T::seeded_state(s)); });
+}
+
+template <typename T> void bench_bits_xso_halves(const std::string& name)
+{
+    bench_bits_halves<T>(name, [](const std::uint64_t s) { return std::make_unique<T>(T::seeded_state(s)); });
+}
+
+/**
+ * Register n_interleaved_streams streams of a generator, made by @p make_streams from the seed of the job as described
+ * by @p seeding, and read in turn through StreamInterleaver. Streams of 64-bit generators give both halves of each
+ * output, so that every stream takes part in both the high and the low bits seen by TestU01.
+ */
+template <typename T>
+void bench_bits_streams(const std::string& name, const std::string& seeding,
+    std::function<std::vector<std::unique_ptr<T>>(std::uint64_t, std::size_t)> make_streams)
+{
+    using Interleaver = StreamInterleaver<T>;
+    const std::size_t n_streams = n_interleaved_streams;
+    const std::string adaptor = std::to_string(n_streams) + " streams by " + seeding;
+    if constexpr (output_bits<T>() == 64) {
+        register_job(name, adaptor + ", " + half_selection_name(HalfSelection::INTERLEAVED),
+            [make_streams = std::move(make_streams), n_streams](const std::string& job_name, const std::uint64_t s) {
+                return std::make_unique<HalvesBenchmarkingHelper<Interleaver>>(
+                    std::make_unique<Interleaver>(make_streams(s, n_streams)), HalfSelection::INTERLEAVED, job_name);
+            });
+    } else {
+        register_job(name, adaptor,
+            [make_streams = std::move(make_streams), n_streams](const std::string& job_name, const std::uint64_t s) {
+                return std::make_unique<StlBenchmarkingHelper<Interleaver>>(
+                    std::make_unique<Interleaver>(make_streams(s, n_streams)), job_name);
+            });
+    }
+}
+
+/**
+ * Register streams seeded with the seed of the job plus their index, cast to the result_type.
+ */
+template <typename T> void bench_bits_adjacent_seeds(const std::string& name)
+{
+    bench_bits_streams<T>(name, "adjacent seeds", [](const std::uint64_t s, const std::size_t n_streams) {
+        return adjacent_seed_streams<T>(
+            [](const std::uint64_t seed) {
+                return std::make_unique<T>(static_cast<typename T::result_type>(seed));
+            },
+            s, n_streams);
+    });
+}
+
+template <typename T> void bench_bits_set_stream(const std::string& name)
+{
+    bench_bits_streams<T>(name, "set_stream", &set_stream_streams<T>);
+}
+
+template <typename T> void bench_bits_advances(const std::string& name)
+{
+    bench_bits_streams<T>(name, "advance", [](const std::uint64_t s, const std::size_t n_streams) {
+        return advanced_streams(T { static_cast<typename T::result_type>(s) }, n_streams);
+    });
+}
+
+/**
+ * Register xoshiro/xoroshiro streams whose states are expanded from adjacent seeds, and streams jumps apart.
+ */
+template <typename T> void bench_bits_xso_streams(const std::string& name)
+{
+    bench_bits_streams<T>(name, "adjacent seeds", [](const std::uint64_t s, const std::size_t n_streams) {
+        return adjacent_seed_streams<T>(
+            [](const std::uint64_t seed) { return std::make_unique<T>(T::seeded_state(seed)); }, s, n_streams);
+    });
+    bench_bits_streams<T>(name, "jump", [](const std::uint64_t s, const std::size_t n_streams) {
+        return XoroshiroStreamFactory<T> { s }.make_streams(n_streams);
+    });
 }
 
 void bench_gsl(const gsl_rng_type* t)
 {
     auto* rng = gsl_rng_alloc(t);
-    GslBenchmarkingHelper { t, "GSL::" + std::string(gsl_rng_name(rng)) }.run();
+    register_job("GSL::" + std::string(gsl_rng_name(rng)), "gsl_rng_uniform_int",
+        [t](const std::string& job_name, const std::uint64_t s) {
+            return std::make_unique<GslBenchmarkingHelper>(t, job_name, s);
+        });
     gsl_rng_free(rng);
 }
 
-void bench_bits_mkl(const MKL_INT type, const std::string& name) { MklBenchmarkingHelper { type, name }.run(); }
+void bench_gsl_packed(const gsl_rng_type* t)
+{
+    bench_bits_packed<GslRngWrapper>("GSL::" + std::string(t->name), [t](const std::uint64_t s) {
+        return std::make_unique<GslRngWrapper>(t, static_cast<GslRngWrapper::result_type>(s));
+    });
+}
+
+void bench_bits_mkl(const MKL_INT type, const std::string& name)
+{
+    register_job(name, "viRngUniformBits32", [type](const std::string& job_name, const std::uint64_t s) {
+        return std::make_unique<MklBenchmarkingHelper>(type, job_name, s);
+    });
+}
+
+/**
+ * Run every registered job, at most @p n_jobs at a time, and return their sections in registry order.
+ *
+ * Jobs whose results are in @p store are skipped unless @p rerun, and get a section rebuilt from the store. The
+ * summaries of the others are parsed into @p store, which is saved after each job, so that an interrupted run keeps
+ * what it completed; jobs without a complete summary, e.g., because of an error, are not stored.
+ */
+std::vector<std::string> run_registry(const std::size_t n_jobs, const BatteryOptions& options, const bool in_process,
+    TestU01ResultStore& store, const bool rerun)
+{
+    std::vector<std::string> sections(registry.size());
+    std::mutex store_mutex;
+    WorkStealingPool pool { n_jobs };
+    pool.run(registry.size(), [&](const std::size_t i) {
+        const TestU01Job& job = registry[i];
+        BatteryOptions job_options = options;
+        job_options.test = job.test;
+        const TestU01Key key { job.name, job.version, job.job_seed, job.adaptor, job_options.label() };
+        // Generators registered with several adaptors are told apart in the sections and logs.
+        const std::string display_name = job.name + " (" + job.adaptor + ")";
+        const std::string header = ">" + display_name + " [" + job_options.label() + "]\n";
+        {
+            const std::lock_guard<std::mutex> lock { store_mutex };
+            const std::vector<TestU01Record>* cached = rerun ? nullptr : store.find(key);
+            if (cached != nullptr) {
+                sections[i] = header + "Cached in " + RESULTS_STORE_PATH + ":\n" + format_testu01_records(*cached);
+                return;
+            }
+        }
+        try {
+            sections[i] = job.make_helper(display_name, job.job_seed)->run(job_options, in_process);
+        } catch (const std::exception& e) {
+            sections[i] = header + "Error: " + e.what() + "\n";
+            return;
+        }
+        if (auto records = parse_testu01_summary(sections[i])) {
+            const std::lock_guard<std::mutex> lock { store_mutex };
+            store.put(key, std::move(*records));
+            store.save();
+        }
+    });
+    return sections;
+}
+
+/**
+ * Replace testu01_results.txt by @p sections at once, so that it is never left half-written.
+ */
+void write_results(const std::vector<std::string>& sections)
+{
+    const std::string temp_path = RESULTS_PATH + ".tmp";
+    {
+        std::ofstream f { temp_path, std::ios::binary };
+        for (const auto& section : sections) {
+            f << section;
+        }
+    }
+    if (std::rename(temp_path.c_str(), RESULTS_PATH.c_str()) != 0) {
+        throw std::system_error(errno, std::generic_category(), "Failed to rename " + temp_path);
+    }
+}
 
 [[maybe_unused]] void stl_main()
 {
-    CustomRandomDevice rng_custom_random_device;
-    bench_bits_stl<decltype(rng_custom_random_device)>(rng_custom_random_device, "CustomRandomDevice");
-    DumbRandomDevice rng_dumb_random_device;
-    bench_bits_stl<decltype(rng_dumb_random_device)>(rng_dumb_random_device, "DumbRandomDevice");
+    library_version = "compiler " __VERSION__;
+    bench_bits_stl<CustomRandomDevice>(
+        "CustomRandomDevice", [](std::uint64_t /* unused */) { return std::make_unique<CustomRandomDevice>(); });
+    bench_bits_stl<DumbRandomDevice>(
+        "DumbRandomDevice", [](std::uint64_t /* unused */) { return std::make_unique<DumbRandomDevice>(); });
 
     // All tests were passed
-    std::mt19937 rng_mt19937 { seed() };
-    bench_bits_stl<decltype(rng_mt19937)>(rng_mt19937, "std::mt19937");
+    bench_bits_stl<std::mt19937>("std::mt19937");
 
-    // All tests were passed
-    std::mt19937_64 rng_mt19937_64 { seed() };
-    bench_bits_stl<std::mt19937_64>(rng_mt19937_64, "std::mt19937_64");
+    // All tests were passed on the high halves
+    bench_bits_halves<std::mt19937_64>("std::mt19937_64");
 
     // All tests were passed
-    std::ranlux48 rng_ranlux48 { seed() };
-    bench_bits_stl<std::ranlux48>(rng_ranlux48, "std::ranlux48");
+    bench_bits_stl<std::ranlux48>("std::ranlux48");
 
-    // Range too small, skipping.
-    // std::ranlux24 rng_ranlux24 { seed() };
-    // bench_bits_stl<std::ranlux24>(rng_ranlux24, "std::ranlux24");
+    // Range below 32 bits.
+    bench_bits_packed<std::ranlux24>("std::ranlux24");
 
     //        Test                          p-value
     // ----------------------------------------------
@@ -264,8 +721,7 @@ void bench_bits_mkl(const MKL_INT type, const std::string& name) { MklBenchmarki
     //  7  WeightDistrib                  1.1e-16
     // ----------------------------------------------
     // All other tests were passed
-    // std::ranlux48_base rng_ranlux48_base { seed() };
-    // bench_bits_stl<std::ranlux48_base>(rng_ranlux48_base, "std::ranlux48_base");
+    // bench_bits_stl<std::ranlux48_base>("std::ranlux48_base");
 
     //        Test                          p-value
     // ----------------------------------------------
@@ -274,12 +730,10 @@ void bench_bits_mkl(const MKL_INT type, const std::string& name) { MklBenchmarki
     //  7  WeightDistrib                    eps
     // ----------------------------------------------
     // All other tests were passed
-    // std::ranlux24_base rng_ranlux24_base { seed() };
-    // bench_bits_stl<std::ranlux24_base>(rng_ranlux24_base, "std::ranlux24_base");
+    // bench_bits_stl<std::ranlux24_base>("std::ranlux24_base");
 
-    // Range too small, skipping.
-    // std::knuth_b rng_knuth_b { seed() };
-    // bench_bits_stl<std::knuth_b>(rng_knuth_b, "std::knuth_b");
+    // Range below 32 bits.
+    bench_bits_packed<std::knuth_b>("std::knuth_b");
 
     //        Test                          p-value
     // ----------------------------------------------
@@ -287,8 +741,7 @@ void bench_bits_mkl(const MKL_INT type, const std::string& name) { MklBenchmarki
     //  2  Collision                      1 - eps1
     // ----------------------------------------------
     // All other tests were passed
-    // std::minstd_rand0 rng_minstd_rand0 { seed() };
-    // bench_bits_stl<std::minstd_rand0>(rng_minstd_rand0, "std::minstd_rand0");
+    // bench_bits_stl<std::minstd_rand0>("std::minstd_rand0");
 
     //        Test                          p-value
     // ----------------------------------------------
@@ -296,39 +749,32 @@ void bench_bits_mkl(const MKL_INT type, const std::string& name) { MklBenchmarki
     //  2  Collision                      1 - eps1
     // ----------------------------------------------
     // All other tests were passed
-    // std::minstd_rand rng_minstd_rand { seed() };
-    // bench_bits_stl<std::minstd_rand>(rng_minstd_rand, "std::minstd_rand");
+    // bench_bits_stl<std::minstd_rand>("std::minstd_rand");
 }
 
 [[maybe_unused]] void boost_main()
 {
+    library_version = "Boost " BOOST_LIB_VERSION;
     // All tests were passed
-    boost::random::mt19937 rng_mt19937 { static_cast<unsigned int>(seed()) };
-    bench_bits_stl<boost::random::mt19937>(rng_mt19937, "boost::random::mt19937");
+    bench_bits_stl<boost::random::mt19937>("boost::random::mt19937");
 
-    // All tests were passed
-    boost::random::mt19937_64 rng_mt19937_64 { seed() };
-    bench_bits_stl<boost::random::mt19937_64>(rng_mt19937_64, "boost::random::mt19937_64");
+    // All tests were passed on the high halves
+    bench_bits_halves<boost::random::mt19937_64>("boost::random::mt19937_64");
 
     // All tests were passed
-    boost::random::ranlux48 rng_ranlux48 { seed() };
-    bench_bits_stl<boost::random::ranlux48>(rng_ranlux48, "boost::random::ranlux48");
+    bench_bits_stl<boost::random::ranlux48>("boost::random::ranlux48");
 
-    // Range too small, skipping.
-    // boost::random::ranlux24 rng_ranlux24 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::ranlux24>(rng_ranlux24, "boost::random::ranlux24");
+    // Range below 32 bits.
+    bench_bits_packed<boost::random::ranlux24>("boost::random::ranlux24");
 
-    // Range too small, skipping.
-    // boost::random::knuth_b rng_knuth_b { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::knuth_b>(rng_knuth_b, "boost::random::knuth_b");
+    // Range below 32 bits.
+    bench_bits_packed<boost::random::knuth_b>("boost::random::knuth_b");
 
-    // Range too small, skipping.
-    // boost::random::minstd_rand0 rng_minstd_rand0 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::minstd_rand0>(rng_minstd_rand0, "boost::random::minstd_rand0");
+    // Range below 32 bits.
+    bench_bits_packed<boost::random::minstd_rand0>("boost::random::minstd_rand0");
 
-    // Range too small, skipping.
-    // boost::random::minstd_rand rng_minstd_rand { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::minstd_rand>(rng_minstd_rand, "boost::random::minstd_rand");
+    // Range below 32 bits.
+    bench_bits_packed<boost::random::minstd_rand>("boost::random::minstd_rand");
 
     //        Test                          p-value
     // ----------------------------------------------
@@ -336,12 +782,10 @@ void bench_bits_mkl(const MKL_INT type, const std::string& name) { MklBenchmarki
     //  7  WeightDistrib                    eps
     // ----------------------------------------------
     // All other tests were passed
-    // boost::random::ranlux48_base rng_ranlux48_base { seed() };
-    // bench_bits_stl<boost::random::ranlux48_base>(rng_ranlux48_base, "boost::random::ranlux48_base");
+    // bench_bits_stl<boost::random::ranlux48_base>("boost::random::ranlux48_base");
 
-    // Range too small, skipping.
-    // boost::random::ranlux24_base rng_ranlux24_base { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::ranlux24_base>(rng_ranlux24_base, "boost::random::ranlux24_base");
+    // Range below 32 bits.
+    bench_bits_packed<boost::random::ranlux24_base>("boost::random::ranlux24_base");
 
     //        Test                          p-value
     // ----------------------------------------------
@@ -349,120 +793,94 @@ void bench_bits_mkl(const MKL_INT type, const std::string& name) { MklBenchmarki
     //  2  Collision                      1 - eps1
     // ----------------------------------------------
     // All other tests were passed
-    // boost::random::rand48 rng_rand48 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::rand48>(rng_rand48, "boost::random::rand48");
-
-    // Range too small, skipping.
-    // boost::random::ecuyer1988 rng_ecuyer1988 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::ecuyer1988>(rng_ecuyer1988, "boost::random::ecuyer1988");
-
-    // Range too small, skipping.
-    // boost::random::kreutzer1986 rng_kreutzer1986 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::kreutzer1986>(rng_kreutzer1986, "boost::random::kreutzer1986");
-
-    // All tests were passed
-    boost::random::taus88 rng_taus88 { static_cast<unsigned int>(seed()) };
-    bench_bits_stl<boost::random::taus88>(rng_taus88, "boost::random::taus88");
-
-    // Range too small, skipping.
-    // boost::random::hellekalek1995 rng_hellekalek1995 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::hellekalek1995>(rng_hellekalek1995, "boost::random::hellekalek1995");
-
-    // All tests were passed
-    boost::random::mt11213b rng_mt11213b { static_cast<unsigned int>(seed()) };
-    bench_bits_stl<boost::random::mt11213b>(rng_mt11213b, "boost::random::mt11213b");
-
-    // Range too small, skipping.
-    // boost::random::lagged_fibonacci607 rng_lagged_fibonacci607 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::lagged_fibonacci607>(rng_lagged_fibonacci607,
-    // "boost::random::lagged_fibonacci607"); boost::random::lagged_fibonacci19937 rng_lagged_fibonacci19937 {
-    // static_cast<unsigned int>(seed()) }; bench_bits_stl<boost::random::lagged_fibonacci19937>(
-    //     rng_lagged_fibonacci19937, "boost::random::lagged_fibonacci19937");
-    // boost::random::lagged_fibonacci9689 rng_lagged_fibonacci9689 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::lagged_fibonacci9689>(
-    //     rng_lagged_fibonacci9689, "boost::random::lagged_fibonacci9689");
-    // boost::random::lagged_fibonacci23209 rng_lagged_fibonacci23209 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::lagged_fibonacci23209>(
-    //     rng_lagged_fibonacci23209, "boost::random::lagged_fibonacci23209");
-    // boost::random::lagged_fibonacci1279 rng_lagged_fibonacci1279 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::lagged_fibonacci1279>(
-    //     rng_lagged_fibonacci1279, "boost::random::lagged_fibonacci1279");
-    // boost::random::lagged_fibonacci3217 rng_lagged_fibonacci3217 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::lagged_fibonacci3217>(
-    //     rng_lagged_fibonacci3217, "boost::random::lagged_fibonacci3217");
-    // boost::random::lagged_fibonacci4423 rng_lagged_fibonacci4423 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::lagged_fibonacci4423>(
-    //     rng_lagged_fibonacci4423, "boost::random::lagged_fibonacci4423");
-    // boost::random::lagged_fibonacci44497 rng_lagged_fibonacci44497 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::lagged_fibonacci44497>(
-    //     rng_lagged_fibonacci44497, "boost::random::lagged_fibonacci44497");
-
-    // Range too small, skipping.
-    // boost::random::ranlux3 rng_ranlux3 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::ranlux3>(rng_ranlux3, "boost::random::ranlux3");
-
-    // Range too small, skipping.
-    // boost::random::ranlux4 rng_ranlux4 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::ranlux4>(rng_ranlux4, "boost::random::ranlux4");
-
-    // All tests were passed
-    boost::random::ranlux64_3 rng_ranlux64_3 { static_cast<unsigned int>(seed()) };
-    bench_bits_stl<boost::random::ranlux64_3>(rng_ranlux64_3, "boost::random::ranlux64_3");
-
-    // All tests were passed
-    boost::random::ranlux64_4 rng_ranlux64_4 { static_cast<unsigned int>(seed()) };
-    bench_bits_stl<boost::random::ranlux64_4>(rng_ranlux64_4, "boost::random::ranlux64_4");
-
-    // Range too small, skipping.
-    // boost::random::ranlux3_01 rng_ranlux3_01 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::ranlux3_01>(rng_ranlux3_01, "boost::random::ranlux3_01");
-    // boost::random::ranlux4_01 rng_ranlux4_01 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::ranlux4_01>(rng_ranlux4_01, "boost::random::ranlux4_01");
-    // boost::random::ranlux64_3_01 rng_ranlux64_3_01 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::ranlux64_3_01>(rng_ranlux64_3_01, "boost::random::ranlux64_3_01");
-    // boost::random::ranlux64_4_01 rng_ranlux64_4_01 { static_cast<unsigned int>(seed()) };
-    // bench_bits_stl<boost::random::ranlux64_4_01>(rng_ranlux64_4_01, "boost::random::ranlux64_4_01");
-}
+    // bench_bits_stl<boost::random::rand48>("boost::random::rand48");
+
+    // Range below 32 bits.
+    bench_bits_packed<boost::random::ecuyer1988>("boost::random::ecuyer1988");
+
+    // Range below 32 bits.
+    bench_bits_packed<boost::random::kreutzer1986>("boost::random::kreutzer1986");
 
-[[maybe_unused]] void absl_main()
-{
     // All tests were passed
-    absl::BitGen rng_bitgen {};
-    bench_bits_stl<absl::BitGen>(rng_bitgen, "absl::BitGen");
+    bench_bits_stl<boost::random::taus88>("boost::random::taus88");
+
+    // Range below 32 bits.
+    bench_bits_packed<boost::random::hellekalek1995>("boost::random::hellekalek1995");
 
     // All tests were passed
-    absl::InsecureBitGen rng_insecure_bitgen {};
-    bench_bits_stl<absl::InsecureBitGen>(rng_insecure_bitgen, "absl::InsecureBitGen");
-}
+    bench_bits_stl<boost::random::mt11213b>("boost::random::mt11213b");
 
-[[maybe_unused]] void pcg_main()
-{ // All tests were passed
-    pcg32 rng_pcg32 { static_cast<unsigned int>(seed()) };
-    bench_bits_stl<pcg32>(rng_pcg32, "PCG::pcg32");
+    // Floating-point output in [0, 1), no bits to pack.
+    // bench_bits_stl<boost::random::lagged_fibonacci607>("boost::random::lagged_fibonacci607");
+    // bench_bits_stl<boost::random::lagged_fibonacci19937>("boost::random::lagged_fibonacci19937");
+    // bench_bits_stl<boost::random::lagged_fibonacci9689>("boost::random::lagged_fibonacci9689");
+    // bench_bits_stl<boost::random::lagged_fibonacci23209>("boost::random::lagged_fibonacci23209");
+    // bench_bits_stl<boost::random::lagged_fibonacci1279>("boost::random::lagged_fibonacci1279");
+    // bench_bits_stl<boost::random::lagged_fibonacci3217>("boost::random::lagged_fibonacci3217");
+    // bench_bits_stl<boost::random::lagged_fibonacci4423>("boost::random::lagged_fibonacci4423");
+    // bench_bits_stl<boost::random::lagged_fibonacci44497>("boost::random::lagged_fibonacci44497");
+
+    // Range below 32 bits.
+    bench_bits_packed<boost::random::ranlux3>("boost::random::ranlux3");
+
+    // Range below 32 bits.
+    bench_bits_packed<boost::random::ranlux4>("boost::random::ranlux4");
 
     // All tests were passed
-    pcg64 rng_pcg64 { static_cast<unsigned int>(seed()) };
-    bench_bits_stl<pcg64>(rng_pcg64, "PCG::pcg64");
+    bench_bits_stl<boost::random::ranlux64_3>("boost::random::ranlux64_3");
 
     // All tests were passed
-    pcg32_fast rng_pcg32_fast { static_cast<unsigned int>(seed()) };
-    bench_bits_stl<pcg32_fast>(rng_pcg32_fast, "PCG::pcg32_fast");
+    bench_bits_stl<boost::random::ranlux64_4>("boost::random::ranlux64_4");
+
+    // Floating-point output in [0, 1), no bits to pack.
+    // bench_bits_stl<boost::random::ranlux3_01>("boost::random::ranlux3_01");
+    // bench_bits_stl<boost::random::ranlux4_01>("boost::random::ranlux4_01");
+    // bench_bits_stl<boost::random::ranlux64_3_01>("boost::random::ranlux64_3_01");
+    // bench_bits_stl<boost::random::ranlux64_4_01>("boost::random::ranlux64_4_01");
+}
+
+[[maybe_unused]] void absl_main()
+{
+#ifdef ABSL_LTS_RELEASE_VERSION
+    library_version = "Abseil " + std::to_string(ABSL_LTS_RELEASE_VERSION);
+#else
+    library_version = "Abseil";
+#endif
+    // All tests were passed on the high halves
+    bench_bits_halves<absl::BitGen>(
+        "absl::BitGen", [](std::uint64_t /* unused */) { return std::make_unique<absl::BitGen>(); });
+
+    // All tests were passed on the high halves
+    bench_bits_halves<absl::InsecureBitGen>(
+        "absl::InsecureBitGen", [](std::uint64_t /* unused */) { return std::make_unique<absl::InsecureBitGen>(); });
+}
+
+[[maybe_unused]] void pcg_main()
+{
+    library_version = "pcg-cpp 0.98";
 
     // All tests were passed
-    pcg64_fast rng_pcg64_fast { static_cast<unsigned int>(seed()) };
-    bench_bits_stl<pcg64_fast>(rng_pcg64_fast, "PCG::pcg64_fast");
+    bench_bits_stl<pcg32>("PCG::pcg32");
+
+    // All tests were passed on the high halves
+    bench_bits_halves<pcg64>("PCG::pcg64");
 
     // All tests were passed
-    pcg32_oneseq_once_insecure rng_pcg32_oneseq_once_insecure { static_cast<unsigned int>(seed()) };
-    bench_bits_stl<pcg32_oneseq_once_insecure>(rng_pcg32_oneseq_once_insecure, "PCG::pcg32_oneseq_once_insecure");
+    bench_bits_stl<pcg32_fast>("PCG::pcg32_fast");
+
+    // All tests were passed on the high halves
+    bench_bits_halves<pcg64_fast>("PCG::pcg64_fast");
 
     // All tests were passed
-    pcg64_oneseq_once_insecure rng_pcg64_oneseq_once_insecure { static_cast<unsigned int>(seed()) };
-    bench_bits_stl<pcg64_oneseq_once_insecure>(rng_pcg64_oneseq_once_insecure, "PCG::pcg64_oneseq_once_insecure");
+    bench_bits_stl<pcg32_oneseq_once_insecure>("PCG::pcg32_oneseq_once_insecure");
+
+    // All tests were passed on the high halves
+    bench_bits_halves<pcg64_oneseq_once_insecure>("PCG::pcg64_oneseq_once_insecure");
 }
 
 [[maybe_unused]] void mkl_main()
 {
+    library_version = "MKL " + std::to_string(INTEL_MKL_VERSION);
     // All tests were passed
     bench_bits_mkl(VSL_BRNG_MT19937, "MKL::VSL_BRNG_MT19937");
 
@@ -500,6 +918,7 @@ void bench_bits_mkl(const MKL_INT type, const std::string& name) { MklBenchmarki
 
 [[maybe_unused]] void gsl_main()
 {
+    library_version = "GSL " GSL_VERSION;
     // All tests were passed
     bench_gsl(gsl_rng_mt19937);
 
@@ -509,14 +928,14 @@ void bench_bits_mkl(const MKL_INT type, const std::string& name) { MklBenchmarki
     // All tests were passed
     bench_gsl(gsl_rng_mt19937_1998);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_ranlxs0);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_ranlxs0);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_ranlxs1);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_ranlxs1);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_ranlxs2);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_ranlxs2);
 
     // All tests were passed
     bench_gsl(gsl_rng_ranlxd1);
@@ -524,17 +943,17 @@ void bench_bits_mkl(const MKL_INT type, const std::string& name) { MklBenchmarki
     // All tests were passed
     bench_gsl(gsl_rng_ranlxd2);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_ranlux);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_ranlux);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_ranlux389);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_ranlux389);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_cmrg);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_cmrg);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_mrg);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_mrg);
 
     // All tests were passed
     bench_gsl(gsl_rng_taus);
@@ -545,17 +964,17 @@ void bench_bits_mkl(const MKL_INT type, const std::string& name) { MklBenchmarki
     // All tests were passed
     bench_gsl(gsl_rng_gfsr4);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_rand);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_rand);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_random_bsd);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_random_bsd);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_random_libc5);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_random_libc5);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_random_glibc2);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_random_glibc2);
 
     //        Test                          p-value
     // ----------------------------------------------
@@ -574,8 +993,8 @@ void bench_bits_mkl(const MKL_INT type, const std::string& name) { MklBenchmarki
     // All other tests were passed
     // bench_gsl(gsl_rng_ranf);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_ranmar);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_ranmar);
 
     //        Test                          p-value
     // ----------------------------------------------
@@ -606,199 +1025,246 @@ void bench_bits_mkl(const MKL_INT type, const std::string& name) { MklBenchmarki
     // All other tests were passed
     // bench_gsl(gsl_rng_vax);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_transputer);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_transputer);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_randu);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_randu);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_minstd);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_minstd);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_uni);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_uni);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_uni32);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_uni32);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_slatec);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_slatec);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_zuf);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_zuf);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_knuthran2);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_knuthran2);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_knuthran2002);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_knuthran2002);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_knuthran);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_knuthran);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_borosh13);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_borosh13);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_fishman18);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_fishman18);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_fishman20);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_fishman20);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_lecuyer21);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_lecuyer21);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_waterman14);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_waterman14);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_fishman2x);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_fishman2x);
 
-    // Range too small, skipping.
-    // bench_gsl(gsl_rng_coveyou);
+    // Range below 32 bits.
+    bench_gsl_packed(gsl_rng_coveyou);
 }
 
 [[maybe_unused]] void other_rngs_main()
 {
+    library_version = "deps/other_rngs";
     // All tests were passed
-    arc4_rand32 rng_arc4 { static_cast<arc4_rand32::result_type>(seed()) };
-    bench_bits_stl<arc4_rand32>(rng_arc4, "others::arc4_rand32");
+    bench_bits_stl<arc4_rand32>("others::arc4_rand32");
 
-    // All tests were passed
-    arc4_rand64 rng_arc4_64 { static_cast<arc4_rand64::result_type>(seed()) };
-    bench_bits_stl<arc4_rand64>(rng_arc4_64, "others::arc4_rand64");
+    // All tests were passed on the high halves
+    bench_bits_halves<arc4_rand64>("others::arc4_rand64");
 
     // All tests were passed
-    gjrand32 rng_gjrand32 { static_cast<gjrand32::result_type>(seed()) };
-    bench_bits_stl<gjrand32>(rng_gjrand32, "others::gjrand32");
+    bench_bits_stl<gjrand32>("others::gjrand32");
 
-    // All tests were passed
-    gjrand64 rng_gjrand63 { static_cast<gjrand64::result_type>(seed()) };
-    bench_bits_stl<gjrand64>(rng_gjrand63, "others::gjrand64");
+    // All tests were passed on the high halves
+    bench_bits_halves<gjrand64>("others::gjrand64");
 
     // All tests were passed
-    jsf32 rng_jsf32 { static_cast<jsf32::result_type>(seed()) };
-    bench_bits_stl<jsf32>(rng_jsf32, "others::jsf32");
+    bench_bits_stl<jsf32>("others::jsf32");
 
     //        Test                          p-value
     // ----------------------------------------------
     // 10  RandomWalk1 M                   0.9996
     // ----------------------------------------------
     // All other tests were passed
-    // jsf64 rng_jsf64 { static_cast<jsf64::result_type>(seed()) };
-    // bench_bits_stl<jsf64>(rng_jsf64, "others::jsf64");
+    // bench_bits_stl<jsf64>("others::jsf64");
 
-    // All tests were passed
-    mcg128 rng_mcg128 { static_cast<mcg128::result_type>(seed()) };
-    bench_bits_stl<mcg128>(rng_mcg128, "others::mcg128");
+    // All tests were passed on the high halves
+    bench_bits_halves<mcg128>("others::mcg128");
 
-    // All tests were passed
-    mcg128_fast rng_mcg128_fast { static_cast<mcg128_fast::result_type>(seed()) };
-    bench_bits_stl<mcg128_fast>(rng_mcg128_fast, "others::mcg128_fast");
+    // All tests were passed on the high halves
+    bench_bits_halves<mcg128_fast>("others::mcg128_fast");
 
     // All tests were passed
-    sfc32 rng_sfc32 { static_cast<sfc32::result_type>(seed()) };
-    bench_bits_stl<sfc32>(rng_sfc32, "others::sfc32");
+    bench_bits_stl<sfc32>("others::sfc32");
 
-    // All tests were passed
-    sfc64 rng_sfc64 { static_cast<sfc64::result_type>(seed()) };
-    bench_bits_stl<sfc64>(rng_sfc64, "others::sfc64");
+    // All tests were passed on the high halves
+    bench_bits_halves<sfc64>("others::sfc64");
 
     // All tests were passed
-    splitmix32 rng_splitmix32 { static_cast<splitmix32::result_type>(seed()) };
-    bench_bits_stl<splitmix32>(rng_splitmix32, "others::splitmix32");
+    bench_bits_stl<splitmix32>("others::splitmix32");
 
-    // All tests were passed
-    splitmix64 rng_splitmix64 { static_cast<splitmix64::result_type>(seed()) };
-    bench_bits_stl<splitmix64>(rng_splitmix64, "others::splitmix64");
+    // All tests were passed on the high halves
+    bench_bits_halves<splitmix64>("others::splitmix64");
 }
 
 [[maybe_unused]] void xso_main()
 {
+    library_version = "deps/xoshiro";
     // All tests were passed
-    XoroshiroWrapper<old::xoroshiro_2x32_star, uint32_t> x01 {};
-    bench_bits_stl<decltype(x01)>(x01, "xoroshiro::2x32*");
+    bench_bits_xso<XoroshiroWrapper<old::xoroshiro_2x32_star, uint32_t>>("xoroshiro::2x32*");
 
     //        Test                          p-value
     // ----------------------------------------------
     // 10  RandomWalk1 J                   0.9998
     // ----------------------------------------------
     // All other tests were passed
-    // XoroshiroWrapper<old::xoroshiro_2x32_star_star, uint32_t> x02 {};
-    // bench_bits_stl<decltype(x02)>(x02, "xoroshiro::2x32**");
+    // bench_bits_xso<XoroshiroWrapper<old::xoroshiro_2x32_star_star, uint32_t>>("xoroshiro::2x32**");
 
     // All tests were passed
-    XoroshiroWrapper<old::xoshiro_4x32_plus, uint32_t, 4> x03 {};
-    bench_bits_stl<decltype(x03)>(x03, "xoshiro::4x32+");
+    bench_bits_xso<XoroshiroWrapper<old::xoshiro_4x32_plus, uint32_t, 4>>("xoshiro::4x32+");
 
     // All tests were passed
-    XoroshiroWrapper<old::xoshiro_4x32_plus_plus, uint32_t, 4> x04 {};
-    bench_bits_stl<decltype(x04)>(x04, "xoshiro::4x32++");
+    bench_bits_xso<XoroshiroWrapper<old::xoshiro_4x32_plus_plus, uint32_t, 4>>("xoshiro::4x32++");
 
     // All tests were passed
-    XoroshiroWrapper<old::xoshiro_4x32_star_star, uint32_t, 4> x05 {};
-    bench_bits_stl<decltype(x05)>(x05, "xoshiro::4x32**");
+    bench_bits_xso<XoroshiroWrapper<old::xoshiro_4x32_star_star, uint32_t, 4>>("xoshiro::4x32**");
 
-    // All tests were passed
-    XoroshiroWrapper<old::xoroshiro_2x64_plus, uint64_t, 2> x06 {};
-    bench_bits_stl<decltype(x06)>(x06, "xoroshiro::2x64+");
+    // All tests were passed on the high halves; prescreen rejects the low halves (linear complexity)
+    bench_bits_xso_halves<XoroshiroWrapper<old::xoroshiro_2x64_plus, uint64_t, 2>>("xoroshiro::2x64+");
 
-    // All tests were passed
-    XoroshiroWrapper<old::xoroshiro_2x64_plus_plus, uint64_t, 2> x07 {};
-    bench_bits_stl<decltype(x07)>(x07, "xoroshiro::2x64++");
+    // All tests were passed on the high halves
+    bench_bits_xso_halves<XoroshiroWrapper<old::xoroshiro_2x64_plus_plus, uint64_t, 2>>("xoroshiro::2x64++");
 
-    // All tests were passed
-    XoroshiroWrapper<old::xoroshiro_2x64_star_star, uint64_t, 2> x08 {};
-    bench_bits_stl<decltype(x08)>(x08, "xoroshiro::2x64**");
+    // All tests were passed on the high halves
+    bench_bits_xso_halves<XoroshiroWrapper<old::xoroshiro_2x64_star_star, uint64_t, 2>>("xoroshiro::2x64**");
 
-    // All tests were passed
-    XoroshiroWrapper<old::xoshiro_4x64_plus, uint64_t, 4> x09 {};
-    bench_bits_stl<decltype(x09)>(x09, "xoshiro::4x64+");
+    // All tests were passed on the high halves
+    bench_bits_xso_halves<XoroshiroWrapper<old::xoshiro_4x64_plus, uint64_t, 4>>("xoshiro::4x64+");
 
-    // All tests were passed
-    XoroshiroWrapper<old::xoshiro_4x64_plus_plus, uint64_t, 4> x10 {};
-    bench_bits_stl<decltype(x10)>(x10, "xoshiro::4x64++");
+    // All tests were passed on the high halves
+    bench_bits_xso_halves<XoroshiroWrapper<old::xoshiro_4x64_plus_plus, uint64_t, 4>>("xoshiro::4x64++");
 
-    // All tests were passed
-    XoroshiroWrapper<old::xoshiro_4x64_star_star, uint64_t, 4> x11 {};
-    bench_bits_stl<decltype(x11)>(x11, "xoshiro::4x64**");
+    // All tests were passed on the high halves
+    bench_bits_xso_halves<XoroshiroWrapper<old::xoshiro_4x64_star_star, uint64_t, 4>>("xoshiro::4x64**");
 
-    // All tests were passed
-    XoroshiroWrapper<old::xoshiro_8x64_plus, uint64_t, 8> x12 {};
-    bench_bits_stl<decltype(x12)>(x12, "xoshiro::8x64+");
+    // All tests were passed on the high halves
+    bench_bits_xso_halves<XoroshiroWrapper<old::xoshiro_8x64_plus, uint64_t, 8>>("xoshiro::8x64+");
 
-    // All tests were passed
-    XoroshiroWrapper<old::xoshiro_8x64_plus_plus, uint64_t, 8> x13 {};
-    bench_bits_stl<decltype(x13)>(x13, "xoshiro::8x64++");
+    // All tests were passed on the high halves
+    bench_bits_xso_halves<XoroshiroWrapper<old::xoshiro_8x64_plus_plus, uint64_t, 8>>("xoshiro::8x64++");
 
-    // All tests were passed
-    XoroshiroWrapper<old::xoshiro_8x64_star_star, uint64_t, 8> x14 {};
-    bench_bits_stl<decltype(x14)>(x14, "xoshiro::8x64**");
+    // All tests were passed on the high halves
+    bench_bits_xso_halves<XoroshiroWrapper<old::xoshiro_8x64_star_star, uint64_t, 8>>("xoshiro::8x64**");
 
-    // All tests were passed
-    XoroshiroWrapper<old::xoroshiro_16x64_star, uint64_t, 16> x15 {};
-    bench_bits_stl<decltype(x15)>(x15, "xoroshiro::16x64*");
+    // All tests were passed on the high halves
+    bench_bits_xso_halves<XoroshiroWrapper<old::xoroshiro_16x64_star, uint64_t, 16>>("xoroshiro::16x64*");
 
-    // All tests were passed
-    XoroshiroWrapper<old::xoroshiro_16x64_star_star, uint64_t, 16> x16 {};
-    bench_bits_stl<decltype(x16)>(x16, "xoroshiro::16x64**");
+    // All tests were passed on the high halves
+    bench_bits_xso_halves<XoroshiroWrapper<old::xoroshiro_16x64_star_star, uint64_t, 16>>("xoroshiro::16x64**");
 
-    // All tests were passed
-    XoroshiroWrapper<old::xoroshiro_16x64_plus_plus, uint64_t, 16> x17 {};
-    bench_bits_stl<decltype(x17)>(x17, "xoroshiro::16x64++");
+    // All tests were passed on the high halves
+    bench_bits_xso_halves<XoroshiroWrapper<old::xoroshiro_16x64_plus_plus, uint64_t, 16>>("xoroshiro::16x64++");
+}
+
+/**
+ * Parallel streams of one generator under the seeding schemes workers use: adjacent seeds, jumps or advances to
+ * disjoint blocks, and PCG's selectable streams.
+ */
+[[maybe_unused]] void streams_main()
+{
+    library_version = "compiler " __VERSION__;
+    bench_bits_adjacent_seeds<std::mt19937>("std::mt19937");
+    bench_bits_adjacent_seeds<std::mt19937_64>("std::mt19937_64");
+
+    library_version = "pcg-cpp 0.98";
+    bench_bits_adjacent_seeds<pcg32>("PCG::pcg32");
+    bench_bits_set_stream<pcg32>("PCG::pcg32");
+    bench_bits_advances<pcg32>("PCG::pcg32");
+    bench_bits_adjacent_seeds<pcg64>("PCG::pcg64");
+    bench_bits_set_stream<pcg64>("PCG::pcg64");
+    bench_bits_advances<pcg64>("PCG::pcg64");
+
+    library_version = "deps/other_rngs";
+    bench_bits_adjacent_seeds<mcg128>("others::mcg128");
+    bench_bits_advances<mcg128>("others::mcg128");
+    bench_bits_adjacent_seeds<sfc64>("others::sfc64");
+    bench_bits_adjacent_seeds<splitmix64>("others::splitmix64");
+    bench_bits_advances<splitmix64>("others::splitmix64");
+
+    library_version = "deps/xoshiro";
+    bench_bits_xso_streams<XoroshiroWrapper<old::xoshiro_4x32_plus_plus, uint32_t, 4>>("xoshiro::4x32++");
+    bench_bits_xso_streams<XoroshiroWrapper<old::xoroshiro_2x64_plus, uint64_t, 2>>("xoroshiro::2x64+");
+    bench_bits_xso_streams<XoroshiroWrapper<old::xoshiro_4x64_star_star, uint64_t, 4>>("xoshiro::4x64**");
 }
 
 } // namespace
 
-int main() noexcept
+int main(const int argc, char* argv[])
 {
+    std::size_t n_jobs = std::max(1U, std::thread::hardware_concurrency());
+    bool in_process = false;
+    BatteryOptions options {};
+    bool split_tests = false;
+    bool rerun = false;
+    std::string adaptor {};
+    for (int i = 1; i < argc; i++) {
+        const std::string arg { argv[i] };
+        if (arg == "--jobs" && i + 1 < argc) {
+            n_jobs = std::max<std::size_t>(1, std::stoul(argv[++i]));
+        } else if (arg == "--in-process") {
+            in_process = true;
+        } else if (arg == "--battery" && i + 1 < argc) {
+            options.battery = argv[++i];
+        } else if (arg == "--test" && i + 1 < argc) {
+            options.test = std::stoi(argv[++i]);
+        } else if (arg == "--bits" && i + 1 < argc) {
+            options.n_bits = std::stod(argv[++i]);
+        } else if (arg == "--split-tests") {
+            split_tests = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            master_seed = std::stoull(argv[++i]);
+        } else if (arg == "--rerun") {
+            rerun = true;
+        } else if (arg == "--adaptor" && i + 1 < argc) {
+            adaptor = argv[++i];
+        } else if (arg == "--streams" && i + 1 < argc) {
+            n_interleaved_streams = std::max<std::size_t>(1, std::stoul(argv[++i]));
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--jobs N] [--in-process] [--battery NAME] [--test I | --split-tests] [--bits N]"
+                         " [--seed S] [--rerun] [--adaptor NAME] [--streams K]\n";
+            return EXIT_FAILURE;
+        }
+    }
+    const int n_tests = testu01_n_tests(options.battery.c_str());
+    if (n_tests < 0 || options.test < 0 || options.test > n_tests) {
+        std::cerr << "Error: unknown battery " << options.battery << " or test " << options.test << ".\n";
+        return EXIT_FAILURE;
+    }
+    if (in_process) {
+        // TestU01 allows one external generator at a time.
+        n_jobs = 1;
+    }
     // Ignore SIGPIPE to prevent crashes when the subprocess exits early
     std::signal(SIGPIPE, SIG_IGN);
-    // Clear previous results
-    std::ofstream { "testu01_results.txt", std::ios::binary }.close();
     // Executable testu01_main should be located in the same directory of this executable.
     testu01_path = (boost::filesystem::read_symlink("/proc/self/exe").parent_path() / "testu01_main").string();
-    if (!boost::filesystem::exists(testu01_path) || !boost::filesystem::is_regular_file(testu01_path)) {
+    if (!in_process
+        && (!boost::filesystem::exists(testu01_path) || !boost::filesystem::is_regular_file(testu01_path))) {
         std::cerr << "Error: testu01_main executable not found in the same directory.\n";
         return EXIT_FAILURE;
     }
@@ -810,6 +1276,21 @@ int main() noexcept
     gsl_main();
     xso_main();
     other_rngs_main();
+    streams_main();
 
+    if (!adaptor.empty()) {
+        // E.g., "low halves" to test only the low bits of 64-bit generators.
+        registry.erase(std::remove_if(registry.begin(), registry.end(),
+                           [&adaptor](const TestU01Job& job) { return job.adaptor != adaptor; }),
+            registry.end());
+    }
+    for (auto& job : registry) {
+        job.test = options.test;
+    }
+    if (split_tests) {
+        split_registry(n_tests);
+    }
+    TestU01ResultStore store { RESULTS_STORE_PATH };
+    write_results(run_registry(n_jobs, options, in_process, store, rerun));
     return EXIT_SUCCESS;
 }
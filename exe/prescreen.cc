@@ -0,0 +1,337 @@
+/**
+ * @brief Screen engines and adaptors with the quick tests of Prescreen, so that the obviously weak ones are dropped
+ * before TestU01 spends hours on them.
+ *
+ * Usage: prescreen [--bytes N] [--seed S] [--filter TEXT] [--stdin]
+ *
+ * Each candidate, an engine read through one adaptor as in bench_testu01, is screened on N bytes (default 1 GiB) of
+ * 32-bit words from seed S (default seed()). --filter keeps the candidates whose "name (adaptor)" contains TEXT. With
+ * --stdin, the 32-bit words read from the standard input are screened instead, e.g., from rand_stream, until N bytes or
+ * the end of the input.
+ *
+ * The low halves of a 64-bit LCG and of xoroshiro 2x64+, whose lowest bits are far from random, are screened as
+ * controls. The exit status is a failure if a control passes or if the SIMD Hamming weights differ from the scalar
+ * ones; rejections of other candidates are results.
+ *
+ * On x86_64 MACHINE, --bytes 268435456 --seed 1 (1 core, AVX-512):
+ *   >others::sfc64 (high halves): 268,435,456 bytes in 0.84 s, 0.32 GB/s
+ *     byte chi-square                   0.1099
+ *     word chi-square                  0.01521
+ *     birthday spacings                 0.2588
+ *     Hamming-weight dependency         0.6685
+ *     linear complexity, bit 0          0.7143
+ *   >MMIX LCG (low halves): 268,435,456 bytes in 0.54 s, 0.49 GB/s
+ *     byte chi-square                        1  REJECTED
+ *     word chi-square                        1  REJECTED
+ *     birthday spacings              1.032e-11  REJECTED
+ *     Hamming-weight dependency              0  REJECTED
+ *     linear complexity, bit 0               0  REJECTED
+ *   >xoroshiro::2x64+ (low halves): 268,435,456 bytes in 0.70 s, 0.39 GB/s
+ *     byte chi-square                    0.351
+ *     word chi-square                   0.1614
+ *     birthday spacings                 0.4834
+ *     Hamming-weight dependency         0.4462
+ *     linear complexity, bit 0               0  REJECTED
+ *   >std::mt19937 (4 streams by adjacent seeds): 268,435,456 bytes in 1.71 s, 0.16 GB/s
+ *     byte chi-square                   0.4892
+ *     word chi-square                   0.4513
+ *     birthday spacings                 0.4668
+ *     Hamming-weight dependency         0.6261
+ *     linear complexity, bit 0          0.4066
+ *       ...
+ *   4 of 35 candidates rejected.
+ *
+ * The 4 rejected candidates are the MMIX LCG by low, interleaved and bit-reversed halves and xoroshiro 2x64+ by low
+ * halves. The 16-bit histograms, which do not fit in L1, and the generators dominate the time.
+ */
+#include "engine_utils.hh"
+#include "prescreen.hh"
+#include "range_packer.hh"
+#include "rprobs.hh"
+#include "stream_interleaver.hh"
+#include "vigna.h"
+#include "xoroshiro_wrapper.hh"
+
+#include <sfc.hpp>
+#include <splitmix.hpp>
+
+#include <pcg_random.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t BUFFER_WORDS = 1UL << 16;
+constexpr std::size_t NAME_LENGTH = 28;
+constexpr std::size_t N_STREAMS = 4;
+
+/**
+ * Fill @p out[0, @p n) with the next 32-bit words of a candidate.
+ */
+using WordFiller = std::function<void(std::uint32_t* out, std::size_t n)>;
+
+struct Candidate {
+    std::string name;
+    std::string adaptor;
+    std::function<WordFiller(std::uint64_t)> make_filler;
+    /** Known to be weak, so that the screen must reject it. */
+    bool control = false;
+};
+
+std::vector<Candidate> candidates;
+
+// Knuth's MMIX LCG modulo 2^64, whose bit k has period 2^(k + 1).
+using MmixLcg = std::linear_congruential_engine<std::uint64_t, 6364136223846793005ULL, 1442695040888963407ULL, 0>;
+
+/**
+ * Add an engine with a full 32-bit range, read as is.
+ */
+template <typename T> void add_words(const std::string& name)
+{
+    candidates.push_back({ name, "raw", [](const std::uint64_t s) -> WordFiller {
+                              auto engine = std::make_shared<T>(static_cast<typename T::result_type>(s));
+                              return [engine](std::uint32_t* out, const std::size_t n) {
+                                  std::generate_n(out, n, [&engine]() { return (*engine)(); });
+                              };
+                          } });
+}
+
+/**
+ * Add a 64-bit engine made by @p make_engine once per HalfSelection; the low halves are a control if @p weak_low_bits.
+ */
+template <typename T>
+void add_halves(const std::string& name, const std::function<std::shared_ptr<T>(std::uint64_t)>& make_engine,
+    const bool weak_low_bits = false)
+{
+    for (const auto selection :
+        { HalfSelection::HIGH, HalfSelection::LOW, HalfSelection::INTERLEAVED, HalfSelection::BIT_REVERSED }) {
+        candidates.push_back({ name, half_selection_name(selection),
+            [make_engine, selection](const std::uint64_t s) -> WordFiller {
+                auto engine = make_engine(s);
+                return [engine, selection](std::uint32_t* out, const std::size_t n) {
+                    fill_u32_halves(*engine, out, n, selection);
+                };
+            },
+            weak_low_bits && selection == HalfSelection::LOW });
+    }
+}
+
+template <typename T> void add_halves(const std::string& name, const bool weak_low_bits = false)
+{
+    add_halves<T>(
+        name, [](const std::uint64_t s) { return std::make_shared<T>(static_cast<typename T::result_type>(s)); },
+        weak_low_bits);
+}
+
+template <typename T> void add_xso_halves(const std::string& name, const bool weak_low_bits = false)
+{
+    add_halves<T>(
+        name, [](const std::uint64_t s) { return std::make_shared<T>(T::seeded_state(s)); }, weak_low_bits);
+}
+
+/**
+ * Add an engine whose range is not a full 32-bit word, packed by RangePacker.
+ */
+template <typename T> void add_packed(const std::string& name)
+{
+    candidates.push_back({ name, "RangePacker<uint32_t>", [](const std::uint64_t s) -> WordFiller {
+                              auto engine = std::make_shared<T>(static_cast<typename T::result_type>(s));
+                              auto packer = std::make_shared<RangePacker<T>>(*engine);
+                              return [engine, packer](std::uint32_t* out, const std::size_t n) {
+                                  packer->fill(out, n);
+                              };
+                          } });
+}
+
+/**
+ * Add N_STREAMS streams made by @p make_streams and read in turn, 64-bit ones by interleaved halves.
+ */
+template <typename T>
+void add_streams(const std::string& name, const std::string& seeding,
+    const std::function<std::vector<std::unique_ptr<T>>(std::uint64_t)>& make_streams)
+{
+    using Interleaver = StreamInterleaver<T>;
+    constexpr bool IS_64_BIT = output_bits<T>() == 64;
+    std::string adaptor = std::to_string(N_STREAMS) + " streams by " + seeding;
+    if (IS_64_BIT) {
+        adaptor += std::string(", ") + half_selection_name(HalfSelection::INTERLEAVED);
+    }
+    candidates.push_back({ name, adaptor, [make_streams](const std::uint64_t s) -> WordFiller {
+                              auto interleaver = std::make_shared<Interleaver>(make_streams(s));
+                              return [interleaver](std::uint32_t* out, const std::size_t n) {
+                                  if constexpr (IS_64_BIT) {
+                                      fill_u32_halves(*interleaver, out, n, HalfSelection::INTERLEAVED);
+                                  } else {
+                                      std::generate_n(out, n, [&interleaver]() { return (*interleaver)(); });
+                                  }
+                              };
+                          } });
+}
+
+void register_candidates()
+{
+    add_words<std::mt19937>("std::mt19937");
+    add_halves<std::mt19937_64>("std::mt19937_64");
+    add_packed<std::minstd_rand>("std::minstd_rand");
+    add_words<pcg32>("PCG::pcg32");
+    add_halves<pcg64>("PCG::pcg64");
+    add_halves<sfc64>("others::sfc64");
+    add_halves<splitmix64>("others::splitmix64");
+    add_halves<MmixLcg>("MMIX LCG", true);
+
+    using Xoroshiro2x64Plus = XoroshiroWrapper<old::xoroshiro_2x64_plus, uint64_t, 2>;
+    using Xoshiro4x64StarStar = XoroshiroWrapper<old::xoshiro_4x64_star_star, uint64_t, 4>;
+    add_xso_halves<Xoroshiro2x64Plus>("xoroshiro::2x64+", true);
+    add_xso_halves<Xoshiro4x64StarStar>("xoshiro::4x64**");
+
+    add_streams<std::mt19937>("std::mt19937", "adjacent seeds", [](const std::uint64_t s) {
+        return adjacent_seed_streams<std::mt19937>(
+            [](const std::uint64_t seed) {
+                return std::make_unique<std::mt19937>(static_cast<std::mt19937::result_type>(seed));
+            },
+            s, N_STREAMS);
+    });
+    add_streams<pcg32>("PCG::pcg32", "set_stream", [](const std::uint64_t s) {
+        return set_stream_streams<pcg32>(s, N_STREAMS);
+    });
+    add_streams<splitmix64>("others::splitmix64", "advance", [](const std::uint64_t s) {
+        return advanced_streams(splitmix64 { s }, N_STREAMS);
+    });
+    add_streams<Xoshiro4x64StarStar>("xoshiro::4x64**", "jump", [](const std::uint64_t s) {
+        return XoroshiroStreamFactory<Xoshiro4x64StarStar> { s }.make_streams(N_STREAMS);
+    });
+}
+
+/**
+ * @return Whether hamming_weights() agrees with hamming_weights_scalar() on lengths around the SIMD widths.
+ */
+bool check_hamming_weights()
+{
+    splitmix64 engine { 1 };
+    std::vector<std::uint32_t> words(1000);
+    fill_u32(engine, words.data(), words.size());
+    std::vector<std::uint8_t> simd(words.size());
+    std::vector<std::uint8_t> scalar(words.size());
+    for (const std::size_t n : { 0UL, 1UL, 15UL, 16UL, 17UL, 31UL, 32UL, 33UL, 1000UL }) {
+        Prescreen::hamming_weights(words.data(), n, simd.data());
+        Prescreen::hamming_weights_scalar(words.data(), n, scalar.data());
+        if (!std::equal(simd.begin(), simd.begin() + static_cast<std::ptrdiff_t>(n), scalar.begin())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Screen the words of @p fill, or of the standard input if it is empty, and print the results.
+ *
+ * @return Whether any test rejected them.
+ */
+bool screen(const std::string& label, const WordFiller& fill, const std::size_t n_bytes)
+{
+    Prescreen prescreen {};
+    std::vector<std::uint32_t> buffer(BUFFER_WORDS);
+    const std::size_t n_words = n_bytes / sizeof(std::uint32_t);
+    auto start = std::chrono::high_resolution_clock::now();
+    while (prescreen.n_words() < n_words) {
+        std::size_t n = std::min(BUFFER_WORDS, n_words - prescreen.n_words());
+        if (fill) {
+            fill(buffer.data(), n);
+        } else {
+            // A partial word at the end of the input is dropped.
+            const ssize_t n_read = read(STDIN_FILENO, buffer.data(), n * sizeof(std::uint32_t));
+            if (n_read <= 0) {
+                break;
+            }
+            n = static_cast<std::size_t>(n_read) / sizeof(std::uint32_t);
+        }
+        prescreen.update(buffer.data(), n);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    const std::size_t n_screened = prescreen.n_words() * sizeof(std::uint32_t);
+
+    std::cout << ">" << label << ": " << formatWithCommas(n_screened) << " bytes in " << std::fixed
+              << std::setprecision(2) << seconds << " s, " << static_cast<double>(n_screened) / seconds / 1e9
+              << " GB/s\n"
+              << std::defaultfloat;
+    bool rejected = false;
+    for (const auto& result : prescreen.results()) {
+        std::cout << "  " << std::left << std::setw(NAME_LENGTH) << result.test << std::right << std::setw(12)
+                  << std::setprecision(4) << result.p_value << (result.rejected() ? "  REJECTED" : "") << "\n";
+        rejected = rejected || result.rejected();
+    }
+    std::cout << std::flush;
+    return rejected;
+}
+
+int usage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--bytes N] [--seed S] [--filter TEXT] [--stdin]\n";
+    return EXIT_FAILURE;
+}
+
+} // namespace
+
+int main(const int argc, char* argv[])
+{
+    std::size_t n_bytes = 1UL << 30;
+    std::uint64_t screen_seed = seed();
+    std::string filter {};
+    bool from_stdin = false;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg { argv[i] };
+        if (arg == "--bytes" && i + 1 < argc) {
+            n_bytes = std::stoull(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            screen_seed = std::stoull(argv[++i]);
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--stdin") {
+            from_stdin = true;
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    const bool weights_ok = check_hamming_weights();
+    std::cout << "SIMD Hamming weights: " << (weights_ok ? "OK" : "FAILED") << std::endl;
+    if (from_stdin) {
+        screen("stdin", WordFiller {}, n_bytes);
+        return weights_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    std::cout << "Seed: " << screen_seed << std::endl;
+    register_candidates();
+    std::size_t n_rejected = 0;
+    std::size_t n_screened = 0;
+    bool controls_ok = true;
+    for (const auto& candidate : candidates) {
+        const std::string label = candidate.name + " (" + candidate.adaptor + ")";
+        if (label.find(filter) == std::string::npos) {
+            continue;
+        }
+        const bool rejected = screen(label, candidate.make_filler(screen_seed), n_bytes);
+        n_screened++;
+        n_rejected += rejected ? 1 : 0;
+        if (candidate.control && !rejected) {
+            std::cout << "  Control not rejected.\n";
+            controls_ok = false;
+        }
+    }
+    std::cout << n_rejected << " of " << n_screened << " candidates rejected." << std::endl;
+    return weights_ok && controls_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
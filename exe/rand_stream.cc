@@ -0,0 +1,345 @@
+/**
+ * @brief Write the raw output of an engine to the standard output or a file, to feed external test suites, e.g.,
+ * PractRand's RNG_test stdin32/stdin64, dieharder -g 200 or gjrand's mcp, and to measure the throughput of pipes.
+ *
+ * Usage: rand_stream ENGINE [--seed S] [--width native|32] [--reverse-bytes] [--bytes N] [--output FILE] [--no-splice]
+ *        rand_stream --list
+ *
+ * Words have the width of the engine, 32 or 64 bits, or are truncated to their low 32 bits with --width 32, and are
+ * written in host byte order unless --reverse-bytes. Without --bytes, the stream only ends when the reader closes the
+ * pipe. The engine fills page-aligned buffers in place; when the output is a pipe, they are handed to it with vmsplice
+ * instead of being copied by write, unless --no-splice. Spliced pages stay referenced by the pipe until read, so the
+ * engine alternates between two halves of a buffer of twice the pipe size, and only overwrites a half once the pipe has
+ * drained it. The seed, the number of bytes and the throughput are reported on stderr, so that a failure found by
+ * the reader can be reproduced with --seed.
+ *
+ * On x86_64 MACHINE, with 1 core shared by both ends of the pipe, for others::sfc64 --bytes 4294967296:
+ *   | cat > /dev/null:              4,294,967,296 bytes in 2.17 s, 1.98 GB/s (vmsplice)
+ *   --no-splice | cat > /dev/null:  4,294,967,296 bytes in 2.44 s, 1.76 GB/s (write)
+ *   --output /dev/null:             4,294,967,296 bytes in 1.56 s, 2.74 GB/s (write)
+ */
+#include "class_utils.hh"
+#include "rprobs.hh"
+#include "vigna.h"
+#include "xoroshiro_wrapper.hh"
+
+#include <arc4.hpp>
+#include <gjrand.hpp>
+#include <jsf.hpp>
+#include <lehmer.hpp>
+#include <sfc.hpp>
+#include <splitmix.hpp>
+
+#include <pcg_random.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <system_error>
+
+namespace {
+
+constexpr std::size_t MAX_PIPE_BYTES = 1UL << 20;
+constexpr std::size_t WRITE_BYTES = 1UL << 20;
+
+enum class Width { NATIVE, TRUNCATED_32 };
+
+struct StreamOptions {
+    Width width = Width::NATIVE;
+    bool reverse_bytes = false;
+};
+
+/**
+ * Fill @p out[0, @p n_bytes) with the next bytes of the stream; @p n_bytes is a multiple of 8.
+ */
+using Filler = std::function<void(unsigned char* out, std::size_t n_bytes)>;
+
+template <typename Word> Word reverse_bytes(const Word word)
+{
+    if constexpr (sizeof(Word) == sizeof(std::uint64_t)) {
+        return __builtin_bswap64(word);
+    } else {
+        return __builtin_bswap32(word);
+    }
+}
+
+template <typename Word, typename Engine>
+void fill_words(Engine& engine, Word* out, const std::size_t n, const bool reverse)
+{
+    if (reverse) {
+        std::generate_n(out, n, [&engine]() { return reverse_bytes(static_cast<Word>(engine())); });
+    } else {
+        std::generate_n(out, n, [&engine]() { return static_cast<Word>(engine()); });
+    }
+}
+
+/**
+ * @return The stream of @p engine, whose output must cover all 32 or all 64 bits.
+ */
+template <typename Engine> Filler make_filler(std::shared_ptr<Engine> engine, const StreamOptions& options)
+{
+    static_assert(Engine::min() == 0, "The output of the engine must start at 0");
+    constexpr bool is_64 = Engine::max() == std::numeric_limits<std::uint64_t>::max();
+    static_assert(is_64 || Engine::max() == std::numeric_limits<std::uint32_t>::max(),
+        "The output of the engine must cover 32 or 64 bits");
+    const bool reverse = options.reverse_bytes;
+    if (is_64 && options.width == Width::NATIVE) {
+        return [engine, reverse](unsigned char* out, const std::size_t n_bytes) {
+            fill_words(*engine, reinterpret_cast<std::uint64_t*>(out), n_bytes / sizeof(std::uint64_t), reverse);
+        };
+    }
+    return [engine, reverse](unsigned char* out, const std::size_t n_bytes) {
+        fill_words(*engine, reinterpret_cast<std::uint32_t*>(out), n_bytes / sizeof(std::uint32_t), reverse);
+    };
+}
+
+using FillerFactory = std::function<Filler(std::uint64_t, const StreamOptions&)>;
+
+template <typename Engine> FillerFactory seeded_with_cast()
+{
+    return [](const std::uint64_t s, const StreamOptions& options) {
+        return make_filler(std::make_shared<Engine>(static_cast<typename Engine::result_type>(s)), options);
+    };
+}
+
+template <typename Engine> FillerFactory seeded_with_state()
+{
+    return [](const std::uint64_t s, const StreamOptions& options) {
+        return make_filler(std::make_shared<Engine>(Engine::seeded_state(s)), options);
+    };
+}
+
+const std::map<std::string, FillerFactory>& engines()
+{
+    static const std::map<std::string, FillerFactory> engines {
+        { "std::mt19937", seeded_with_cast<std::mt19937>() },
+        { "std::mt19937_64", seeded_with_cast<std::mt19937_64>() },
+        { "PCG::pcg32", seeded_with_cast<pcg32>() },
+        { "PCG::pcg64", seeded_with_cast<pcg64>() },
+        { "PCG::pcg32_fast", seeded_with_cast<pcg32_fast>() },
+        { "PCG::pcg64_fast", seeded_with_cast<pcg64_fast>() },
+        { "others::arc4_rand32", seeded_with_cast<arc4_rand32>() },
+        { "others::arc4_rand64", seeded_with_cast<arc4_rand64>() },
+        { "others::gjrand32", seeded_with_cast<gjrand32>() },
+        { "others::gjrand64", seeded_with_cast<gjrand64>() },
+        { "others::jsf32", seeded_with_cast<jsf32>() },
+        { "others::jsf64", seeded_with_cast<jsf64>() },
+        { "others::mcg128", seeded_with_cast<mcg128>() },
+        { "others::mcg128_fast", seeded_with_cast<mcg128_fast>() },
+        { "others::sfc32", seeded_with_cast<sfc32>() },
+        { "others::sfc64", seeded_with_cast<sfc64>() },
+        { "others::splitmix32", seeded_with_cast<splitmix32>() },
+        { "others::splitmix64", seeded_with_cast<splitmix64>() },
+        { "xoroshiro::2x32*", seeded_with_state<XoroshiroWrapper<old::xoroshiro_2x32_star, uint32_t>>() },
+        { "xoroshiro::2x32**", seeded_with_state<XoroshiroWrapper<old::xoroshiro_2x32_star_star, uint32_t>>() },
+        { "xoshiro::4x32+", seeded_with_state<XoroshiroWrapper<old::xoshiro_4x32_plus, uint32_t, 4>>() },
+        { "xoshiro::4x32++", seeded_with_state<XoroshiroWrapper<old::xoshiro_4x32_plus_plus, uint32_t, 4>>() },
+        { "xoshiro::4x32**", seeded_with_state<XoroshiroWrapper<old::xoshiro_4x32_star_star, uint32_t, 4>>() },
+        { "xoroshiro::2x64+", seeded_with_state<XoroshiroWrapper<old::xoroshiro_2x64_plus, uint64_t, 2>>() },
+        { "xoroshiro::2x64++", seeded_with_state<XoroshiroWrapper<old::xoroshiro_2x64_plus_plus, uint64_t, 2>>() },
+        { "xoroshiro::2x64**", seeded_with_state<XoroshiroWrapper<old::xoroshiro_2x64_star_star, uint64_t, 2>>() },
+        { "xoshiro::4x64+", seeded_with_state<XoroshiroWrapper<old::xoshiro_4x64_plus, uint64_t, 4>>() },
+        { "xoshiro::4x64++", seeded_with_state<XoroshiroWrapper<old::xoshiro_4x64_plus_plus, uint64_t, 4>>() },
+        { "xoshiro::4x64**", seeded_with_state<XoroshiroWrapper<old::xoshiro_4x64_star_star, uint64_t, 4>>() },
+        { "xoshiro::8x64+", seeded_with_state<XoroshiroWrapper<old::xoshiro_8x64_plus, uint64_t, 8>>() },
+        { "xoshiro::8x64++", seeded_with_state<XoroshiroWrapper<old::xoshiro_8x64_plus_plus, uint64_t, 8>>() },
+        { "xoshiro::8x64**", seeded_with_state<XoroshiroWrapper<old::xoshiro_8x64_star_star, uint64_t, 8>>() },
+        { "xoroshiro::16x64*", seeded_with_state<XoroshiroWrapper<old::xoroshiro_16x64_star, uint64_t, 16>>() },
+        { "xoroshiro::16x64**", seeded_with_state<XoroshiroWrapper<old::xoroshiro_16x64_star_star, uint64_t, 16>>() },
+        { "xoroshiro::16x64++", seeded_with_state<XoroshiroWrapper<old::xoroshiro_16x64_plus_plus, uint64_t, 16>>() },
+    };
+    return engines;
+}
+
+/**
+ * Page-aligned anonymous mapping.
+ */
+class Buffer {
+public:
+    explicit Buffer(const std::size_t n_bytes)
+        : data_ { mmap(nullptr, n_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) }
+        , n_bytes_ { n_bytes }
+    {
+        if (data_ == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "Failed to map the buffer");
+        }
+    }
+    ~Buffer() { munmap(data_, n_bytes_); }
+    DELETE_COPY_MOVE(Buffer)
+
+    [[nodiscard]] unsigned char* data() const { return static_cast<unsigned char*>(data_); }
+
+private:
+    void* data_;
+    std::size_t n_bytes_;
+};
+
+/**
+ * Write @p data[0, @p n_bytes) to @p fd, with vmsplice if @p is_pipe.
+ *
+ * @return false if the reader closed the pipe.
+ */
+bool write_all(const int fd, const unsigned char* data, std::size_t n_bytes, const bool is_pipe)
+{
+    while (n_bytes > 0) {
+        ssize_t n_written = 0;
+        if (is_pipe) {
+            iovec iov { const_cast<unsigned char*>(data), n_bytes };
+            n_written = vmsplice(fd, &iov, 1, 0);
+        } else {
+            n_written = write(fd, data, n_bytes);
+        }
+        if (n_written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EPIPE) {
+                return false;
+            }
+            throw std::system_error(errno, std::generic_category(), "Failed to write the stream");
+        }
+        data += n_written;
+        n_bytes -= static_cast<std::size_t>(n_written);
+    }
+    return true;
+}
+
+/**
+ * Write the stream of @p fill to @p fd until @p limit bytes, if any, or until the reader closes the pipe.
+ *
+ * @return The number of bytes written.
+ */
+std::size_t stream(const Filler& fill, const int fd, const bool is_pipe, const std::optional<std::size_t> limit)
+{
+    std::size_t chunk_bytes = WRITE_BYTES;
+    if (is_pipe) {
+        // The pipe may refuse to grow, e.g., beyond /proc/sys/fs/pipe-max-size; only its actual size matters.
+        fcntl(fd, F_SETPIPE_SZ, static_cast<int>(MAX_PIPE_BYTES));
+        const int pipe_bytes = fcntl(fd, F_GETPIPE_SZ);
+        if (pipe_bytes < 0) {
+            throw std::system_error(errno, std::generic_category(), "Failed to get the size of the pipe");
+        }
+        chunk_bytes = static_cast<std::size_t>(pipe_bytes);
+    }
+    // Once a half has been spliced entirely, the pipe, which holds at most one half, has drained the other one.
+    const Buffer buffer { 2 * chunk_bytes };
+    std::size_t n_written = 0;
+    for (std::size_t half = 0; !limit || n_written < *limit; half ^= 1) {
+        unsigned char* chunk = buffer.data() + half * chunk_bytes;
+        const std::size_t n_bytes = limit ? std::min(chunk_bytes, *limit - n_written) : chunk_bytes;
+        fill(chunk, (n_bytes + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t) * sizeof(std::uint64_t));
+        if (!write_all(fd, chunk, n_bytes, is_pipe)) {
+            break;
+        }
+        n_written += n_bytes;
+    }
+    return n_written;
+}
+
+int usage(const char* program)
+{
+    std::cerr << "Usage: " << program
+              << " ENGINE [--seed S] [--width native|32] [--reverse-bytes] [--bytes N] [--output FILE] [--no-splice]\n"
+              << "       " << program << " --list\n";
+    return EXIT_FAILURE;
+}
+
+} // namespace
+
+int main(const int argc, char* argv[])
+{
+    if (argc < 2) {
+        return usage(argv[0]);
+    }
+    const std::string engine_name { argv[1] };
+    if (engine_name == "--list") {
+        for (const auto& [name, factory] : engines()) {
+            std::cout << name << "\n";
+        }
+        return EXIT_SUCCESS;
+    }
+    std::uint64_t stream_seed = seed();
+    StreamOptions options {};
+    std::optional<std::size_t> limit {};
+    std::string output_path {};
+    bool splice = true;
+    for (int i = 2; i < argc; i++) {
+        const std::string arg { argv[i] };
+        if (arg == "--seed" && i + 1 < argc) {
+            stream_seed = std::stoull(argv[++i]);
+        } else if (arg == "--width" && i + 1 < argc) {
+            const std::string width { argv[++i] };
+            if (width != "native" && width != "32") {
+                return usage(argv[0]);
+            }
+            options.width = width == "32" ? Width::TRUNCATED_32 : Width::NATIVE;
+        } else if (arg == "--reverse-bytes") {
+            options.reverse_bytes = true;
+        } else if (arg == "--bytes" && i + 1 < argc) {
+            limit = std::stoull(argv[++i]);
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_path = argv[++i];
+        } else if (arg == "--no-splice") {
+            splice = false;
+        } else {
+            return usage(argv[0]);
+        }
+    }
+    const auto factory = engines().find(engine_name);
+    if (factory == engines().end()) {
+        std::cerr << "Error: unknown engine " << engine_name << "; see --list.\n";
+        return EXIT_FAILURE;
+    }
+
+    // A closed pipe is the normal end of an unlimited stream, reported as EPIPE.
+    std::signal(SIGPIPE, SIG_IGN);
+    int fd = STDOUT_FILENO;
+    if (!output_path.empty()) {
+        fd = open(output_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            std::cerr << "Error: cannot open " << output_path << ".\n";
+            return EXIT_FAILURE;
+        }
+    }
+    struct stat status { };
+    const bool is_pipe = splice && fstat(fd, &status) == 0 && S_ISFIFO(status.st_mode);
+
+    try {
+        const Filler fill = factory->second(stream_seed, options);
+        auto start = std::chrono::high_resolution_clock::now();
+        const std::size_t n_bytes = stream(fill, fd, is_pipe, limit);
+        auto end = std::chrono::high_resolution_clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        std::cerr << engine_name << " (seed " << stream_seed << "): " << formatWithCommas(n_bytes) << " bytes in "
+                  << std::fixed << std::setprecision(2) << seconds << " s, "
+                  << static_cast<double>(n_bytes) / seconds / 1e9 << " GB/s (" << (is_pipe ? "vmsplice" : "write")
+                  << ")" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    if (fd != STDOUT_FILENO) {
+        close(fd);
+    }
+    return EXIT_SUCCESS;
+}
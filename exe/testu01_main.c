@@ -1,26 +1,124 @@
+/* pread and syscall are GNU/POSIX extensions, hidden by the strict -std=c11 of CMAKE_C_EXTENSIONS OFF. */
+#define _GNU_SOURCE
+
+#include "shm_ring.h"
+#include "testu01_batteries.h"
+
 #include <TestU01.h>
 
+#include <sys/mman.h>
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-int main(void)
+/* Ring of shm_ring.h shared with bench_testu01, and the words read from it but not yet released. */
+static struct shm_ring* ring = NULL;
+static uint32_t ring_tail = 0;
+static uint32_t ring_head = 0;
+
+/*
+ * External generator reading from the ring. The tail is published once every quarter of the ring or when the
+ * available words run out, rather than after every word.
+ */
+static unsigned int ring_bits(void)
+{
+    if (ring_tail == ring_head) {
+        shm_ring_publish(&ring->tail, ring_tail, &ring->producer_waiting);
+        while ((ring_head = shm_ring_await_change(&ring->head, ring_tail, &ring->consumer_waiting)) == ring_tail) {
+            if (__atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE) != 0
+                && __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == ring_tail) {
+                fprintf(stderr, "The generator stopped before the battery ended\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+    } else if ((ring_tail & ((ring->capacity >> 2) - 1)) == 0) {
+        shm_ring_publish(&ring->tail, ring_tail, &ring->producer_waiting);
+    }
+    const unsigned int bits = shm_ring_data(ring)[ring_tail & (ring->capacity - 1)];
+    ring_tail++;
+    return bits;
+}
+
+static unif01_Gen* create_ring_gen(const int fd)
+{
+    struct shm_ring header;
+    if (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+        perror("Failed to read the ring buffer");
+        return NULL;
+    }
+    void* mapping = mmap(NULL, shm_ring_size(header.capacity), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        perror("Failed to map the ring buffer");
+        return NULL;
+    }
+    ring = (struct shm_ring*)mapping;
+    ring_tail = ring->tail;
+    ring_head = ring_tail;
+    return unif01_CreateExternGenBits("ring", ring_bits);
+}
+
+static unif01_Gen* create_stdin_gen(void)
 {
     const char* temp_file = "/dev/stdin";
     char* filename = (char*)malloc(strlen(temp_file) + 1);
     if (filename == NULL) {
         fprintf(stderr, "Memory allocation failed\n");
-        return EXIT_FAILURE;
+        return NULL;
     }
     strncpy(filename, temp_file, strlen(temp_file) + 1);
 
     unif01_Gen* gen = ufile_CreateReadBin(filename, 4096);
     free(filename);
+    return gen;
+}
+
+/*
+ * Usage: testu01_main [--ring FD] [--battery NAME] [--test I] [--bits N]
+ *
+ * Reads 32-bit words from the shared-memory ring in file descriptor FD, as written by bench_testu01, or from the
+ * standard input otherwise. Runs battery NAME (SmallCrush by default, Crush, BigCrush, Rabbit or Alphabit), or only
+ * its test number I; Rabbit and Alphabit take N bits.
+ */
+int main(int argc, char* argv[])
+{
+    int ring_fd = -1;
+    const char* battery = "SmallCrush";
+    int test = 0;
+    double n_bits = TESTU01_DEFAULT_N_BITS;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ring") == 0 && i + 1 < argc) {
+            ring_fd = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--battery") == 0 && i + 1 < argc) {
+            battery = argv[++i];
+        } else if (strcmp(argv[i], "--test") == 0 && i + 1 < argc) {
+            test = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--bits") == 0 && i + 1 < argc) {
+            n_bits = strtod(argv[++i], NULL);
+        } else {
+            fprintf(stderr, "Usage: %s [--ring FD] [--battery NAME] [--test I] [--bits N]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    const int n_tests = testu01_n_tests(battery);
+    if (n_tests < 0 || test < 0 || test > n_tests) {
+        fprintf(stderr, "Unknown battery %s or test %d\n", battery, test);
+        return EXIT_FAILURE;
+    }
+
+    unif01_Gen* gen = ring_fd >= 0 ? create_ring_gen(ring_fd) : create_stdin_gen();
+    if (gen == NULL) {
+        return EXIT_FAILURE;
+    }
 
     swrite_Basic = FALSE;
-    bbattery_SmallCrush(gen);
+    testu01_run_battery(gen, battery, test, n_bits);
 
-    unif01_DeleteExternGenBits(gen);
+    if (ring_fd >= 0) {
+        unif01_DeleteExternGenBits(gen);
+    } else {
+        ufile_DeleteReadBin(gen);
+    }
 
     return EXIT_SUCCESS;
 }
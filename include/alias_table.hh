@@ -0,0 +1,72 @@
+#pragma once
+
+#include "engine_utils.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Walker/Vose alias table for sampling from a small discrete distribution in O(1).
+ *
+ * Each column is packed into an 8-byte entry holding the acceptance threshold and the alias index next to each other,
+ * so one draw touches exactly one entry. The threshold is stored as a 32-bit integer and compared against raw engine
+ * bits, which avoids any floating-point conversion on the sampling path.
+ *
+ * One draw consumes 64 random bits: the high half selects the column by multiply-shift, the low half is compared
+ * against the threshold of that column.
+ */
+class AliasTable {
+public:
+    struct Entry {
+        std::uint32_t threshold;
+        std::uint32_t alias;
+    };
+    static_assert(sizeof(Entry) == 8, "AliasTable::Entry should be packed into 8 bytes");
+
+    /**
+     * @param weights Non-negative weights of the outcomes. They need not be normalised but should not all be zero.
+     */
+    explicit AliasTable(const std::vector<double>& weights);
+
+    template <typename Engine> std::uint32_t operator()(Engine& engine) const
+    {
+        return lookup(next_u64(engine));
+    }
+
+    /**
+     * Fill @p out with @p n samples.
+     *
+     * Random bits are generated in blocks before the table is looked up, so that the engine and the lookup loops do
+     * not interleave with each other.
+     */
+    template <typename Engine, typename T> void sample(Engine& engine, T* out, std::size_t n) const
+    {
+        constexpr std::size_t BLOCK_SIZE = 256;
+        std::uint64_t bits[BLOCK_SIZE];
+        while (n > 0) {
+            const std::size_t this_block = n < BLOCK_SIZE ? n : BLOCK_SIZE;
+            for (std::size_t i = 0; i < this_block; ++i) {
+                bits[i] = next_u64(engine);
+            }
+            for (std::size_t i = 0; i < this_block; ++i) {
+                out[i] = static_cast<T>(lookup(bits[i]));
+            }
+            out += this_block;
+            n -= this_block;
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const { return entries_.size(); }
+    [[nodiscard]] const std::vector<Entry>& entries() const { return entries_; }
+
+private:
+    [[nodiscard]] std::uint32_t lookup(const std::uint64_t bits) const
+    {
+        const auto column = static_cast<std::uint32_t>(((bits >> 32) * entries_.size()) >> 32);
+        const Entry& entry = entries_[column];
+        return static_cast<std::uint32_t>(bits) < entry.threshold ? column : entry.alias;
+    }
+
+    std::vector<Entry> entries_;
+};
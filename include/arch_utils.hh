@@ -7,3 +7,11 @@
 #else
 #error "Unsupported architecture"
 #endif
+
+// Alignment that keeps data written by different threads off each other's cache lines. Some ARM cores, e.g., Apple's,
+// use 128-byte lines.
+#ifdef BENCH_RAND_ARCH_ARM
+#define BENCH_RAND_CACHE_LINE_SIZE 128
+#else
+#define BENCH_RAND_CACHE_LINE_SIZE 64
+#endif
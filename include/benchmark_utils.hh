@@ -3,6 +3,7 @@
 #include "rprobs.hh"
 
 #include <cmath>
+#include <cstddef>
 #include <cstdlib>
 #include <iomanip>
 #include <numeric>
@@ -34,3 +35,8 @@ template <typename T> T sd(const std::vector<T>& data, T mean_)
 }
 
 std::string describe(const std::vector<std::size_t>& times);
+
+/**
+ * @return The powers of 2 up to the number of hardware threads, and at least up to 4, for scaling benchmarks.
+ */
+std::vector<std::size_t> thread_counts();
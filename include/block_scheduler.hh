@@ -0,0 +1,134 @@
+#pragma once
+
+#include "class_utils.hh"
+#include "substreams.hh"
+#include "xoroshiro_wrapper.hh"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * Fixed set of threads running batches of indexed tasks, with one task queue per thread and stealing between them.
+ *
+ * Each run() hands every thread a contiguous range of task indices; a thread takes work from the back of its own queue
+ * and, once empty, steals from the front of the others'. Which thread runs a task is therefore not deterministic, so
+ * tasks must not depend on it.
+ */
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(std::size_t n_threads = std::thread::hardware_concurrency());
+    DELETE_COPY_MOVE(WorkStealingPool)
+    ~WorkStealingPool();
+
+    /**
+     * Call @p task with every index in [0, @p n_tasks) and wait for all of them.
+     *
+     * The first exception thrown by a task is rethrown here after the other tasks have finished. Not to be called
+     * from several threads at once.
+     */
+    void run(std::size_t n_tasks, const std::function<void(std::size_t)>& task);
+
+    [[nodiscard]] std::size_t size() const { return workers_.size(); }
+
+private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::size_t> tasks;
+    };
+
+    void work(std::size_t worker_id);
+    bool pop_or_steal(std::size_t worker_id, std::size_t& task_id);
+
+    std::vector<std::unique_ptr<TaskQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    std::uint64_t generation_ = 0;
+    bool stopping_ = false;
+    std::atomic<const std::function<void(std::size_t)>*> task_ { nullptr };
+    std::atomic<std::size_t> pending_ { 0 };
+    std::exception_ptr error_;
+};
+
+/**
+ * Engine for block i of an engine with O(log n) advance: the engine seeded with the master seed, advanced by i blocks.
+ *
+ * The period is cut into 2^32 blocks of 2^(period_pow2 - 32) draws each, e.g., 2^32 draws for SplitMix64 or PCG32 and
+ * 2^94 for the 128-bit MCGs.
+ */
+template <typename Engine> class AdvanceBlockEngines {
+public:
+    using Traits = SubstreamTraits<Engine>;
+    using delta_type = typename Traits::delta_type;
+    static constexpr std::size_t MAX_BLOCKS_LOG2 = 32;
+
+    explicit AdvanceBlockEngines(const std::uint64_t master_seed)
+        : base_ { static_cast<delta_type>(master_seed) }
+    {
+    }
+
+    template <typename Fn> void with_engine(const std::size_t block, Fn&& fn) const
+    {
+        if ((static_cast<std::uint64_t>(block) >> MAX_BLOCKS_LOG2) != 0) {
+            throw std::out_of_range("Block index exceeds 2^32");
+        }
+        Engine engine = base_;
+        engine.advance(static_cast<delta_type>(block) << (Traits::period_pow2 - MAX_BLOCKS_LOG2));
+        std::forward<Fn>(fn)(engine);
+    }
+
+private:
+    Engine base_;
+};
+
+/**
+ * Engine for block i of a xoshiro/xoroshiro generator: the state expanded from the master seed, jumped i times.
+ *
+ * Jumps cost a fixed number of next() calls each, so the states of all blocks are computed once, sequentially, on
+ * construction.
+ */
+template <typename Wrapper> class JumpBlockEngines {
+public:
+    using state_type = typename Wrapper::state_type;
+
+    JumpBlockEngines(const std::uint64_t master_seed, const std::size_t n_blocks)
+        : states_ { jumped_states<Wrapper>(master_seed, n_blocks) }
+    {
+    }
+
+    template <typename Fn> void with_engine(const std::size_t block, Fn&& fn) const
+    {
+        Wrapper engine { states_.at(block) };
+        std::forward<Fn>(fn)(engine);
+    }
+
+private:
+    std::vector<state_type> states_;
+};
+
+/**
+ * Run @p fn(block, engine) for every block in [0, @p n_blocks) on @p pool.
+ *
+ * The engine of a block depends only on the master seed of @p engines and the block index, so as long as @p fn writes
+ * its results by block, the output is bit-identical whatever the number of threads or the order of execution.
+ */
+template <typename BlockEngines, typename Fn>
+void run_blocks(WorkStealingPool& pool, const BlockEngines& engines, const std::size_t n_blocks, Fn&& fn)
+{
+    pool.run(n_blocks, [&engines, &fn](const std::size_t block) {
+        engines.with_engine(block, [&fn, block](auto& engine) { fn(block, engine); });
+    });
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "engine_utils.hh"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Natural logarithm of @p n positive normal doubles, 4 at a time with AVX2 where available.
+ *
+ * Uses the range reduction and minimax polynomial of fdlibm's log, so results are within 1 ulp of std::log. Zero,
+ * negative, subnormal and non-finite inputs are not handled. @p in and @p out may be the same array.
+ */
+void vlog(const double* in, double* out, std::size_t n);
+
+/**
+ * Standard exponential variates by inverse CDF, -log(U), with U generated in bulk and vlog() applied to the block.
+ */
+template <typename Engine> void fill_exponential(Engine& engine, double* out, std::size_t n)
+{
+    constexpr std::size_t BLOCK_SIZE = 256;
+    while (n > 0) {
+        const std::size_t this_block = n < BLOCK_SIZE ? n : BLOCK_SIZE;
+        fill_uniform01_positive(engine, out, this_block);
+        vlog(out, out, this_block);
+        for (std::size_t i = 0; i < this_block; ++i) {
+            out[i] = -out[i];
+        }
+        out += this_block;
+        n -= this_block;
+    }
+}
+
+/**
+ * Standard normal variates by Marsaglia's polar method, with the logarithms of accepted pairs taken in bulk.
+ */
+template <typename Engine> void fill_normal(Engine& engine, double* out, std::size_t n)
+{
+    constexpr std::size_t BLOCK_SIZE = 128;
+    double v1[BLOCK_SIZE];
+    double v2[BLOCK_SIZE];
+    double s[BLOCK_SIZE];
+    double log_s[BLOCK_SIZE];
+    while (n > 0) {
+        // Each accepted pair gives two variates.
+        const std::size_t n_pairs = (n < 2 * BLOCK_SIZE ? n + 1 : 2 * BLOCK_SIZE) / 2;
+        std::size_t accepted = 0;
+        while (accepted < n_pairs) {
+            const double x = 2.0 * uniform01(engine) - 1.0;
+            const double y = 2.0 * uniform01(engine) - 1.0;
+            const double r = x * x + y * y;
+            if (r < 1.0 && r > 0.0) {
+                v1[accepted] = x;
+                v2[accepted] = y;
+                s[accepted] = r;
+                ++accepted;
+            }
+        }
+        vlog(s, log_s, n_pairs);
+        for (std::size_t i = 0; i < n_pairs; ++i) {
+            const double factor = std::sqrt(-2.0 * log_s[i] / s[i]);
+            out[0] = v1[i] * factor;
+            if (n > 1) {
+                out[1] = v2[i] * factor;
+                out += 2;
+                n -= 2;
+            } else {
+                out += 1;
+                n -= 1;
+            }
+        }
+    }
+}
+
+/**
+ * Standard exponential variates by the 256-layer Ziggurat of Marsaglia and Tsang (2000).
+ *
+ * One 64-bit word is used per draw: the low 8 bits select the layer and the high 53 bits give the abscissa, so the
+ * two are independent. About 99% of the draws are accepted with one comparison and one multiplication.
+ */
+class ZigguratExponential {
+public:
+    ZigguratExponential();
+
+    template <typename Engine> double operator()(Engine& engine) const
+    {
+        while (true) {
+            const std::uint64_t bits = next_u64(engine);
+            const std::size_t layer = bits & 0xFF;
+            const std::uint64_t x_bits = bits >> 11;
+            const double x = static_cast<double>(x_bits) * w_[layer];
+            if (x_bits < k_[layer]) {
+                return x;
+            }
+            if (layer == 0) {
+                // Tail beyond the base layer is an exponential shifted by R.
+                return R - std::log(1.0 - uniform01(engine));
+            }
+            if (f_[layer] + uniform01(engine) * (f_[layer - 1] - f_[layer]) < std::exp(-x)) {
+                return x;
+            }
+        }
+    }
+
+    template <typename Engine> void fill(Engine& engine, double* out, const std::size_t n) const
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = operator()(engine);
+        }
+    }
+
+    static constexpr double R = 7.69711747013104972;
+    static constexpr double V = 3.949659822581572e-3;
+
+private:
+    std::uint64_t k_[256] {};
+    double w_[256] {};
+    double f_[256] {};
+};
+
+/**
+ * Gamma variates by Marsaglia and Tsang (2000), with normals and uniforms generated in bulk.
+ *
+ * Shapes below 1 are boosted to shape + 1 and multiplied by U^(1 / shape). Throws std::invalid_argument unless the
+ * shape and the scale are positive.
+ */
+class GammaSampler {
+public:
+    explicit GammaSampler(double shape, double scale = 1.0);
+
+    template <typename Engine> void fill(Engine& engine, double* out, std::size_t n) const
+    {
+        constexpr std::size_t BLOCK_SIZE = 256;
+        double normals[BLOCK_SIZE];
+        double uniforms[BLOCK_SIZE];
+        double* const begin = out;
+        const std::size_t total = n;
+        while (n > 0) {
+            fill_normal(engine, normals, BLOCK_SIZE);
+            fill_uniform01_positive(engine, uniforms, BLOCK_SIZE);
+            for (std::size_t i = 0; i < BLOCK_SIZE && n > 0; ++i) {
+                const double x = normals[i];
+                const double t = 1.0 + c_ * x;
+                if (t <= 0.0) {
+                    continue;
+                }
+                const double v = t * t * t;
+                const double u = uniforms[i];
+                const double x2 = x * x;
+                // Squeeze first; the logarithms are only needed for the few per cent it does not decide.
+                if (u < 1.0 - 0.0331 * x2 * x2 || std::log(u) < 0.5 * x2 + d_ * (1.0 - v + std::log(v))) {
+                    *out++ = d_ * v * scale_;
+                    --n;
+                }
+            }
+        }
+        if (boost_) {
+            double* dst = begin;
+            for (std::size_t remaining = total; remaining > 0;) {
+                const std::size_t this_block = remaining < BLOCK_SIZE ? remaining : BLOCK_SIZE;
+                fill_uniform01_positive(engine, uniforms, this_block);
+                vlog(uniforms, uniforms, this_block);
+                for (std::size_t i = 0; i < this_block; ++i) {
+                    dst[i] *= std::exp(uniforms[i] * inv_shape_);
+                }
+                dst += this_block;
+                remaining -= this_block;
+            }
+        }
+    }
+
+private:
+    double scale_;
+    double inv_shape_;
+    bool boost_;
+    double d_;
+    double c_;
+};
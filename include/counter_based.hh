@@ -0,0 +1,125 @@
+#pragma once
+
+#include <splitmix.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Counter-based generation: value(key, counter) is word @p counter of the stream of @p key, computed in O(1) without
+ * any state, so that, e.g., the randomness of one read at one position can be regenerated without replaying its
+ * stream, and shards can start anywhere. fill(key, counter_begin, out, n) gives the same words as n calls of value().
+ */
+
+/**
+ * Philox4x32-10 of Salmon et al., "Parallel random numbers: as easy as 1, 2, 3" (SC'11), as in Random123.
+ *
+ * The 64-bit key is the Philox key; block b of the stream is Philox of the counter (b, 0), and gives words 2b and
+ * 2b + 1, low 32 bits first.
+ */
+class Philox4x32 {
+public:
+    using result_type = std::uint64_t;
+    using counter_type = std::array<std::uint32_t, 4>;
+    using key_type = std::array<std::uint32_t, 2>;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type { 0 }; }
+
+    static counter_type block(counter_type counter, key_type key)
+    {
+        for (std::size_t round = 0; round < N_ROUNDS; ++round) {
+            if (round > 0) {
+                key[0] += W0;
+                key[1] += W1;
+            }
+            const std::uint64_t product0 = std::uint64_t { M0 } * counter[0];
+            const std::uint64_t product1 = std::uint64_t { M1 } * counter[2];
+            counter = { static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                static_cast<std::uint32_t>(product1), static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                static_cast<std::uint32_t>(product0) };
+        }
+        return counter;
+    }
+
+    static result_type value(const std::uint64_t key, const std::uint64_t counter)
+    {
+        const counter_type words = block(block_counter(counter >> 1), split_key(key));
+        return (counter & 1) == 0 ? join(words[0], words[1]) : join(words[2], words[3]);
+    }
+
+    static void fill(const std::uint64_t key, std::uint64_t counter, result_type* out, const std::size_t n)
+    {
+        const key_type split = split_key(key);
+        result_type* const end = out + n;
+        if (out != end && (counter & 1) == 1) {
+            *out++ = value(key, counter++);
+        }
+        for (; end - out >= 2; counter += 2) {
+            const counter_type words = block(block_counter(counter >> 1), split);
+            *out++ = join(words[0], words[1]);
+            *out++ = join(words[2], words[3]);
+        }
+        if (out != end) {
+            *out = value(key, counter);
+        }
+    }
+
+private:
+    static constexpr std::size_t N_ROUNDS = 10;
+    static constexpr std::uint32_t M0 = 0xD2511F53;
+    static constexpr std::uint32_t M1 = 0xCD9E8D57;
+    static constexpr std::uint32_t W0 = 0x9E3779B9;
+    static constexpr std::uint32_t W1 = 0xBB67AE85;
+
+    static counter_type block_counter(const std::uint64_t b)
+    {
+        return { static_cast<std::uint32_t>(b), static_cast<std::uint32_t>(b >> 32), 0, 0 };
+    }
+    static key_type split_key(const std::uint64_t key)
+    {
+        return { static_cast<std::uint32_t>(key), static_cast<std::uint32_t>(key >> 32) };
+    }
+    static result_type join(const std::uint32_t low, const std::uint32_t high)
+    {
+        return std::uint64_t { low } | (std::uint64_t { high } << 32);
+    }
+};
+
+/**
+ * SplitMix64 keyed like Java's SplittableRandom: the stream of @p key is that of splitmix64 { key }.split(), whose
+ * seed and odd gamma both depend on the key, so streams of different keys are not shifts of each other. Word i is
+ * the mix of seed + i * gamma, so any word costs one multiplication and one mix once the key is expanded.
+ *
+ * Cheaper than Philox4x32 but a weaker guarantee: the mixer only passes the batteries, it is not a keyed bijection
+ * designed for adversarial counters.
+ */
+class SplitMixCounter {
+public:
+    using result_type = std::uint64_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type { 0 }; }
+
+    /**
+     * @return The engine producing the stream of @p key from word @p counter on.
+     */
+    static splitmix64 stream(const std::uint64_t key, const std::uint64_t counter)
+    {
+        splitmix64 parent { key };
+        splitmix64 child = parent.split();
+        child.advance(counter);
+        return child;
+    }
+
+    static result_type value(const std::uint64_t key, const std::uint64_t counter) { return stream(key, counter)(); }
+
+    static void fill(const std::uint64_t key, const std::uint64_t counter, result_type* out, const std::size_t n)
+    {
+        splitmix64 engine = stream(key, counter);
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = engine();
+        }
+    }
+};
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "engine_utils.hh"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/**
+ * log(k!) minus its Stirling approximation (k + 1/2) log(k + 1) - (k + 1) + log(sqrt(2 pi)).
+ */
+double stirling_correction(std::int64_t k);
+
+/**
+ * log(k!) through Stirling's formula and stirling_correction(), with a single call to log.
+ */
+double log_factorial(std::int64_t k);
+
+/**
+ * Poisson variates.
+ *
+ * Means below 10 use the multiplication method; larger means use PTRS, the transformed rejection with squeeze of
+ * Hörmann (1993), which needs about 1.2 pairs of uniforms per variate whatever the mean.
+ */
+class PoissonSampler {
+public:
+    explicit PoissonSampler(double mean);
+
+    template <typename Engine> std::int64_t operator()(Engine& engine) const
+    {
+        if (mean_ <= 0.0) {
+            return 0;
+        }
+        return mean_ < PTRS_MIN_MEAN ? multiplication(engine) : ptrs(engine);
+    }
+
+    template <typename Engine> void sample(Engine& engine, std::int64_t* out, const std::size_t n) const
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = operator()(engine);
+        }
+    }
+
+    [[nodiscard]] double mean() const { return mean_; }
+
+    static constexpr double PTRS_MIN_MEAN = 10.0;
+
+private:
+    template <typename Engine> std::int64_t multiplication(Engine& engine) const
+    {
+        std::int64_t k = 0;
+        double prod = uniform01(engine);
+        while (prod > exp_neg_mean_) {
+            prod *= uniform01(engine);
+            ++k;
+        }
+        return k;
+    }
+
+    template <typename Engine> std::int64_t ptrs(Engine& engine) const
+    {
+        while (true) {
+            const double u = uniform01(engine) - 0.5;
+            const double v = uniform01(engine);
+            const double us = 0.5 - std::abs(u);
+            // Kept as a double until checked: us may be zero.
+            const double kd = std::floor((2.0 * a_ / us + b_) * u + mean_ + 0.43);
+            if (us >= 0.07 && v <= v_r_) {
+                return static_cast<std::int64_t>(kd);
+            }
+            if (kd < 0.0 || (us < 0.013 && v > us)) {
+                continue;
+            }
+            if (std::log(v * inv_alpha_ / (a_ / (us * us) + b_))
+                <= -mean_ + kd * log_mean_ - log_factorial(static_cast<std::int64_t>(kd))) {
+                return static_cast<std::int64_t>(kd);
+            }
+        }
+    }
+
+    double mean_;
+    double exp_neg_mean_ = 0.0;
+    double log_mean_ = 0.0;
+    double a_ = 0.0;
+    double b_ = 0.0;
+    double inv_alpha_ = 0.0;
+    double v_r_ = 0.0;
+};
+
+/**
+ * Binomial variates.
+ *
+ * When min(p, 1 - p) * (n + 1) is below 11, sequential inversion is used; otherwise BTRD, the transformed rejection
+ * with decomposition of Hörmann (1993). p > 0.5 is handled by sampling failures instead of successes.
+ */
+class BinomialSampler {
+public:
+    BinomialSampler(std::int64_t trials, double p);
+
+    template <typename Engine> std::int64_t operator()(Engine& engine) const
+    {
+        if (p_ <= 0.0) {
+            return flipped_ ? trials_ : 0;
+        }
+        const std::int64_t k = use_inversion_ ? inversion(engine) : btrd(engine);
+        return flipped_ ? trials_ - k : k;
+    }
+
+    template <typename Engine> void sample(Engine& engine, std::int64_t* out, const std::size_t n) const
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = operator()(engine);
+        }
+    }
+
+private:
+    template <typename Engine> std::int64_t inversion(Engine& engine) const
+    {
+        while (true) {
+            double u = uniform01(engine);
+            double r = q_n_;
+            std::int64_t k = 0;
+            while (u > r) {
+                u -= r;
+                ++k;
+                const double next_r = r * (nr_ / static_cast<double>(k) - r_);
+                // Once the probabilities are past the mode and vanishing, the rest of u is rounding error.
+                if (next_r < std::numeric_limits<double>::epsilon() && next_r < r) {
+                    break;
+                }
+                r = next_r;
+            }
+            if (k <= trials_) {
+                return k;
+            }
+        }
+    }
+
+    template <typename Engine> std::int64_t btrd(Engine& engine) const
+    {
+        while (true) {
+            double v = uniform01(engine);
+            double u = 0.0;
+            if (v <= u_rv_r_) {
+                u = v / v_r_ - 0.43;
+                return static_cast<std::int64_t>(std::floor((2.0 * a_ / (0.5 - std::abs(u)) + b_) * u + c_));
+            }
+            if (v >= v_r_) {
+                u = uniform01(engine) - 0.5;
+            } else {
+                u = v / v_r_ - 0.93;
+                u = (u < 0.0 ? -0.5 : 0.5) - u;
+                v = uniform01(engine) * v_r_;
+            }
+
+            const double us = 0.5 - std::abs(u);
+            // Kept as a double until checked: us may be zero.
+            const double kd = std::floor((2.0 * a_ / us + b_) * u + c_);
+            if (kd < 0.0 || kd > static_cast<double>(trials_)) {
+                continue;
+            }
+            const auto k = static_cast<std::int64_t>(kd);
+            v = v * alpha_ / (a_ / (us * us) + b_);
+            const auto km = static_cast<double>(k > m_ ? k - m_ : m_ - k);
+            if (km <= 15.0) {
+                // Recursive evaluation of f(k) / f(m).
+                double f = 1.0;
+                for (std::int64_t i = m_ + 1; i <= k; ++i) {
+                    f *= nr_ / static_cast<double>(i) - r_;
+                }
+                for (std::int64_t i = k + 1; i <= m_; ++i) {
+                    v *= nr_ / static_cast<double>(i) - r_;
+                }
+                if (v <= f) {
+                    return k;
+                }
+                continue;
+            }
+
+            // Squeeze on log(v), then the exact test with Stirling's formula.
+            v = std::log(v);
+            const double rho = (km / npq_) * (((km / 3.0 + 0.625) * km + 1.0 / 6.0) / npq_ + 0.5);
+            const double t = -km * km / (2.0 * npq_);
+            if (v < t - rho) {
+                return k;
+            }
+            if (v > t + rho) {
+                continue;
+            }
+            const auto nk = static_cast<double>(trials_ - k + 1);
+            if (v <= h_ + static_cast<double>(trials_ + 1) * std::log(nm_ / nk)
+                    + (kd + 0.5) * std::log(nk * r_ / (kd + 1.0)) - stirling_correction(k)
+                    - stirling_correction(trials_ - k)) {
+                return k;
+            }
+        }
+    }
+
+    std::int64_t trials_;
+    double p_;
+    bool flipped_;
+    bool use_inversion_;
+    std::int64_t m_ = 0;
+    double r_ = 0.0;
+    double nr_ = 0.0;
+    double q_n_ = 0.0;
+    double npq_ = 0.0;
+    double a_ = 0.0;
+    double b_ = 0.0;
+    double c_ = 0.0;
+    double alpha_ = 0.0;
+    double v_r_ = 0.0;
+    double u_rv_r_ = 0.0;
+    double nm_ = 0.0;
+    double h_ = 0.0;
+};
+
+/**
+ * Batched Poisson variates where every element has its own mean.
+ */
+template <typename Engine>
+void sample_poisson(Engine& engine, const double* means, std::int64_t* out, const std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = PoissonSampler { means[i] }(engine);
+    }
+}
+
+/**
+ * Batched binomial variates where every element has its own number of trials and success probability.
+ */
+template <typename Engine>
+void sample_binomial(
+    Engine& engine, const std::int64_t* trials, const double* probs, std::int64_t* out, const std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = BinomialSampler { trials[i], probs[i] }(engine);
+    }
+}
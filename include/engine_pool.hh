@@ -0,0 +1,154 @@
+#pragma once
+
+#include "arch_utils.hh"
+#include "class_utils.hh"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * Fixed set of engines lent to short tasks through a lock-free freelist.
+ *
+ * Every engine sits on its own cache line(s), so tasks on different cores never write to a shared line. The free
+ * engines form a Treiber stack whose head packs the index of the top engine with a 32-bit tag against ABA. acquire()
+ * returns a Lease that gives the engine back when it goes out of scope.
+ *
+ * Engines are lent in no particular order, so results depend on scheduling. Use run_blocks() of block_scheduler.hh
+ * where runs must be reproducible.
+ */
+template <typename Engine> class EnginePool {
+    static constexpr std::uint32_t EMPTY = ~std::uint32_t { 0 };
+    static constexpr std::uint64_t TAG_MASK = ~std::uint64_t { 0 } << 32;
+    static constexpr std::uint64_t TAG_ONE = std::uint64_t { 1 } << 32;
+
+    struct alignas(BENCH_RAND_CACHE_LINE_SIZE) Slot {
+        template <typename Init>
+        explicit Slot(Init&& init)
+            : engine { std::forward<Init>(init) }
+        {
+        }
+        Engine engine;
+        std::atomic<std::uint32_t> next { EMPTY };
+    };
+
+public:
+    class Lease {
+    public:
+        Lease(EnginePool* pool, const std::uint32_t index)
+            : pool_ { pool }
+            , index_ { index }
+        {
+        }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease(Lease&& other) noexcept
+            : pool_ { std::exchange(other.pool_, nullptr) }
+            , index_ { other.index_ }
+        {
+        }
+        Lease& operator=(Lease&& other) noexcept
+        {
+            if (this != &other) {
+                release();
+                pool_ = std::exchange(other.pool_, nullptr);
+                index_ = other.index_;
+            }
+            return *this;
+        }
+        ~Lease() { release(); }
+
+        explicit operator bool() const { return pool_ != nullptr; }
+        Engine& operator*() const { return pool_->slots_[index_]->engine; }
+        Engine* operator->() const { return &pool_->slots_[index_]->engine; }
+
+    private:
+        void release()
+        {
+            if (pool_ != nullptr) {
+                pool_->push(index_);
+                pool_ = nullptr;
+            }
+        }
+
+        EnginePool* pool_;
+        std::uint32_t index_;
+    };
+
+    /**
+     * Construct engine i from @p inits[i], e.g., the output of split() of substreams.hh for engines with advance(),
+     * or of jumped_states() of xoroshiro_wrapper.hh for xoshiro generators.
+     */
+    template <typename Init> explicit EnginePool(const std::vector<Init>& inits)
+    {
+        if (inits.empty() || inits.size() >= EMPTY) {
+            throw std::invalid_argument("EnginePool needs between 1 and 2^32 - 2 engines");
+        }
+        slots_.reserve(inits.size());
+        for (const auto& init : inits) {
+            slots_.emplace_back(std::make_unique<Slot>(init));
+        }
+        for (std::uint32_t i = 0; i < slots_.size(); ++i) {
+            push(i);
+        }
+    }
+    DELETE_COPY_MOVE(EnginePool)
+    ~EnginePool() = default;
+
+    /**
+     * @return A lease on a free engine, or an empty one if all are lent.
+     */
+    Lease try_acquire()
+    {
+        std::uint64_t head = head_.load(std::memory_order_acquire);
+        while (true) {
+            const auto index = static_cast<std::uint32_t>(head);
+            if (index == EMPTY) {
+                return Lease { nullptr, EMPTY };
+            }
+            const std::uint32_t next = slots_[index]->next.load(std::memory_order_relaxed);
+            // Every push bumps the tag, so the exchange fails if the head was popped and pushed back meanwhile.
+            const std::uint64_t new_head = (head & TAG_MASK) | next;
+            if (head_.compare_exchange_weak(head, new_head, std::memory_order_acquire, std::memory_order_acquire)) {
+                return Lease { this, index };
+            }
+        }
+    }
+
+    /**
+     * Like try_acquire(), but yields until an engine is free.
+     */
+    Lease acquire()
+    {
+        while (true) {
+            Lease lease = try_acquire();
+            if (lease) {
+                return lease;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const { return slots_.size(); }
+
+private:
+    void push(const std::uint32_t index)
+    {
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        while (true) {
+            slots_[index]->next.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+            const std::uint64_t new_head = ((head & TAG_MASK) + TAG_ONE) | index;
+            if (head_.compare_exchange_weak(head, new_head, std::memory_order_release, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Slot>> slots_;
+    alignas(BENCH_RAND_CACHE_LINE_SIZE) std::atomic<std::uint64_t> head_ { EMPTY };
+};
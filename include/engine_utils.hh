@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @return 32 or 64, the number of raw bits in each output of @p Engine, which must cover a whole 32- or 64-bit range.
+ *
+ * Decided by range rather than by the size of result_type, which has 64 bits for std::mt19937 (uint_fast32_t) on LP64.
+ */
+template <typename Engine> constexpr int output_bits()
+{
+    constexpr auto range = static_cast<std::uint64_t>(Engine::max() - Engine::min());
+    constexpr std::uint64_t range_32 = std::numeric_limits<std::uint32_t>::max();
+    constexpr std::uint64_t range_64 = std::numeric_limits<std::uint64_t>::max();
+    static_assert(range == range_32 || range == range_64, "Raw bits only from a whole 32- or 64-bit range.");
+    return range == range_32 ? 32 : 64;
+}
+
+/**
+ * Draw 64 raw bits from an engine whose output covers its whole 32- or 64-bit result type.
+ *
+ * 32-bit engines are called twice, with the first call providing the high half.
+ */
+template <typename Engine> inline std::uint64_t next_u64(Engine& engine)
+{
+    if constexpr (output_bits<Engine>() == 64) {
+        return static_cast<std::uint64_t>(engine());
+    } else {
+        const auto high = static_cast<std::uint64_t>(static_cast<std::uint32_t>(engine()));
+        return (high << 32) | static_cast<std::uint32_t>(engine());
+    }
+}
+
+/**
+ * Draw 32 raw bits from an engine whose output covers its whole 32- or 64-bit result type.
+ *
+ * 64-bit engines keep the high half, which is the better half for LCG-based and xoroshiro+ engines.
+ */
+template <typename Engine> inline std::uint32_t next_u32(Engine& engine)
+{
+    if constexpr (output_bits<Engine>() == 64) {
+        return static_cast<std::uint32_t>(static_cast<std::uint64_t>(engine()) >> 32);
+    } else {
+        return static_cast<std::uint32_t>(engine());
+    }
+}
+
+/**
+ * Fill @p out with @p n raw 32-bit words.
+ *
+ * Both halves of every output of a 64-bit engine are used, so the engine is called about n / 2 times.
+ */
+template <typename Engine> inline void fill_u32(Engine& engine, std::uint32_t* out, std::size_t n)
+{
+    if constexpr (output_bits<Engine>() == 64) {
+        std::size_t i = 0;
+        for (; i + 1 < n; i += 2) {
+            const auto bits = static_cast<std::uint64_t>(engine());
+            out[i] = static_cast<std::uint32_t>(bits >> 32);
+            out[i + 1] = static_cast<std::uint32_t>(bits);
+        }
+        if (i < n) {
+            out[i] = next_u32(engine);
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = static_cast<std::uint32_t>(engine());
+        }
+    }
+}
+
+/**
+ * Which 32 bits of the outputs of a 64-bit engine feed a 32-bit consumer such as TestU01. Consumers look mostly at the
+ * high bits of a word, so weaknesses confined to the low bits, as in xoroshiro+ and LCG-based engines, only show with
+ * LOW or BIT_REVERSED.
+ */
+enum class HalfSelection {
+    /** The high half of each output, which is what std::uniform_int_distribution<std::uint32_t> keeps. */
+    HIGH,
+    LOW,
+    /** Both halves of each output, high first, as in fill_u32(). */
+    INTERLEAVED,
+    /** Both halves of each output with its bits reversed, so the low bits come first and most significant. */
+    BIT_REVERSED,
+};
+
+inline const char* half_selection_name(const HalfSelection selection)
+{
+    switch (selection) {
+    case HalfSelection::HIGH:
+        return "high halves";
+    case HalfSelection::LOW:
+        return "low halves";
+    case HalfSelection::INTERLEAVED:
+        return "interleaved halves";
+    default:
+        return "bit-reversed halves";
+    }
+}
+
+inline std::uint64_t reverse_bits(std::uint64_t bits)
+{
+    bits = ((bits >> 1) & 0x5555555555555555ULL) | ((bits & 0x5555555555555555ULL) << 1);
+    bits = ((bits >> 2) & 0x3333333333333333ULL) | ((bits & 0x3333333333333333ULL) << 2);
+    bits = ((bits >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((bits & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return __builtin_bswap64(bits);
+}
+
+/**
+ * Fill @p out with @p n 32-bit words selected by @p selection from the outputs of @p engine, whose output must cover
+ * all 64 bits. No distribution is involved, and INTERLEAVED and BIT_REVERSED call the engine about n / 2 times.
+ */
+template <typename Engine>
+inline void fill_u32_halves(Engine& engine, std::uint32_t* out, const std::size_t n, const HalfSelection selection)
+{
+    const auto split = [&engine, out, n](auto&& transform) {
+        std::size_t i = 0;
+        for (; i + 1 < n; i += 2) {
+            const std::uint64_t bits = transform(static_cast<std::uint64_t>(engine()));
+            out[i] = static_cast<std::uint32_t>(bits >> 32);
+            out[i + 1] = static_cast<std::uint32_t>(bits);
+        }
+        if (i < n) {
+            out[i] = static_cast<std::uint32_t>(transform(static_cast<std::uint64_t>(engine())) >> 32);
+        }
+    };
+    switch (selection) {
+    case HalfSelection::HIGH:
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(engine()) >> 32);
+        }
+        break;
+    case HalfSelection::LOW:
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = static_cast<std::uint32_t>(engine());
+        }
+        break;
+    case HalfSelection::INTERLEAVED:
+        split([](const std::uint64_t bits) { return bits; });
+        break;
+    case HalfSelection::BIT_REVERSED:
+        split([](const std::uint64_t bits) { return reverse_bits(bits); });
+        break;
+    }
+}
+
+/**
+ * Uniform double in [0, 1) from the top 53 of 64 raw bits.
+ */
+template <typename Engine> inline double uniform01(Engine& engine)
+{
+    return static_cast<double>(next_u64(engine) >> 11) * 0x1.0p-53;
+}
+
+/**
+ * Fill @p out with @p n uniform doubles in [0, 1), one 64-bit word each.
+ */
+template <typename Engine> inline void fill_uniform01(Engine& engine, double* out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = static_cast<double>(next_u64(engine) >> 11) * 0x1.0p-53;
+    }
+}
+
+/**
+ * Fill @p out with @p n uniform doubles in (0, 1], which is what log-based transforms need.
+ */
+template <typename Engine> inline void fill_uniform01_positive(Engine& engine, double* out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = static_cast<double>((next_u64(engine) >> 11) + 1) * 0x1.0p-53;
+    }
+}
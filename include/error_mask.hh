@@ -0,0 +1,58 @@
+#pragma once
+
+#include "engine_utils.hh"
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Turn a run of Phred qualities into a packed bitmask of which bases carry a sequencing error.
+ *
+ * Base i mutates with probability 10^(-Q_i / 10). The probabilities are precomputed as 32-bit integer thresholds, so
+ * a base mutates iff a raw 32-bit engine word is below the threshold of its quality. No floating-point conversion is
+ * done per base, and the comparison is done 8 (AVX2) or 16 (AVX-512) bases at a time where available.
+ *
+ * Bit (i % 64) of mask[i / 64] is set iff base i mutates. The mask should have room for (n + 63) / 64 words, and
+ * bits past n in the last word are cleared.
+ */
+class ErrorMaskKernel {
+public:
+    /**
+     * @param qual_offset Offset of the quality encoding, e.g., 0 for raw Phred scores or 33 for Sanger FASTQ.
+     */
+    explicit ErrorMaskKernel(int qual_offset = 0);
+
+    /**
+     * Compute the mask from caller-provided random words, one per base.
+     */
+    void apply(const std::uint8_t* quals, const std::uint32_t* bits, std::size_t n, std::uint64_t* mask) const;
+
+    /**
+     * Same as apply(), but without SIMD. Kept for benchmarking and as a fallback.
+     */
+    void apply_scalar(const std::uint8_t* quals, const std::uint32_t* bits, std::size_t n, std::uint64_t* mask) const;
+
+    template <typename Engine>
+    void operator()(Engine& engine, const std::uint8_t* quals, std::size_t n, std::uint64_t* mask) const
+    {
+        // Should be a multiple of 64 so that every block starts on a fresh mask word.
+        constexpr std::size_t BLOCK_SIZE = 1024;
+        std::uint32_t bits[BLOCK_SIZE];
+        while (n > 0) {
+            const std::size_t this_block = n < BLOCK_SIZE ? n : BLOCK_SIZE;
+            fill_u32(engine, bits, this_block);
+            apply(quals, bits, this_block, mask);
+            quals += this_block;
+            mask += BLOCK_SIZE / 64;
+            n -= this_block;
+        }
+    }
+
+    /**
+     * Mutation threshold of an encoded quality. Every possible byte is covered, so no bound check is needed.
+     */
+    [[nodiscard]] std::uint32_t threshold(const std::uint8_t qual) const { return thresholds_[qual]; }
+
+private:
+    alignas(64) std::uint32_t thresholds_[256] {};
+};
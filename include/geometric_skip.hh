@@ -0,0 +1,75 @@
+#pragma once
+
+#include "engine_utils.hh"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Sample sparse per-base error events by skipping ahead instead of drawing once per base.
+ *
+ * Base i mutates with probability p_i = 10^(-Q_i / 10), i.e., it carries a hazard of h_i = -log(1 - p_i). One
+ * exponential variate E is drawn per event, and the next event is at the first base where the cumulative hazard since
+ * the previous event exceeds E. Within a run of equal qualities the hazard is constant, so the gap is found with one
+ * division (a geometric variate); across runs the left-over hazard is carried over. Hence the number of random draws
+ * per read is the number of events plus one, whatever the qualities are.
+ *
+ * The mask layout is the same as for ErrorMaskKernel.
+ */
+class GeometricSkipSampler {
+public:
+    /**
+     * @param qual_offset Offset of the quality encoding, e.g., 0 for raw Phred scores or 33 for Sanger FASTQ.
+     */
+    explicit GeometricSkipSampler(int qual_offset = 0);
+
+    /**
+     * Call @p on_event with the position of every mutated base, in increasing order.
+     */
+    template <typename Engine, typename Callback>
+    void for_each_event(Engine& engine, const std::uint8_t* quals, const std::size_t n, Callback&& on_event) const
+    {
+        double remaining = draw_exponential(engine);
+        std::size_t pos = 0;
+        while (pos < n) {
+            const std::uint8_t qual = quals[pos];
+            std::size_t run_end = pos + 1;
+            while (run_end < n && quals[run_end] == qual) {
+                ++run_end;
+            }
+            const double hazard = hazards_[qual];
+            while (pos < run_end) {
+                // Number of whole bases the left-over hazard survives. Compared as doubles as the quotient may
+                // exceed any integer when the hazard is tiny.
+                const double skip = std::floor(remaining / hazard);
+                if (skip >= static_cast<double>(run_end - pos)) {
+                    remaining -= static_cast<double>(run_end - pos) * hazard;
+                    pos = run_end;
+                    break;
+                }
+                pos += static_cast<std::size_t>(skip);
+                on_event(pos);
+                ++pos;
+                remaining = draw_exponential(engine);
+            }
+        }
+    }
+
+    template <typename Engine>
+    void operator()(Engine& engine, const std::uint8_t* quals, const std::size_t n, std::uint64_t* mask) const
+    {
+        std::memset(mask, 0, (n + 63) / 64 * sizeof(std::uint64_t));
+        for_each_event(engine, quals, n, [mask](const std::size_t pos) { mask[pos / 64] |= 1ULL << (pos % 64); });
+    }
+
+private:
+    template <typename Engine> static double draw_exponential(Engine& engine)
+    {
+        // 1 - U is in (0, 1], so the log is finite.
+        return -std::log(1.0 - uniform01(engine));
+    }
+
+    double hazards_[256] {};
+};
@@ -1,7 +1,9 @@
 #pragma once
 #include "class_utils.hh"
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #include <mkl.h>
 
@@ -20,3 +22,34 @@ private:
     result_type min_;
     result_type max_;
 };
+
+/**
+ * One MKL stream per worker, created with one of the parallel-use patterns of the VSL.
+ *
+ * - MT2203_SET: stream i is generator VSL_BRNG_MT2203 + i of the 6024 independent MT2203 parameter sets; the basic
+ *   generator passed is ignored.
+ * - SKIP_AHEAD: stream i is the basic generator skipped ahead by i * block_size outputs (vslSkipAheadStream).
+ * - LEAPFROG: stream i takes outputs i, i + n, i + 2n, ... of the basic generator (vslLeapfrogStream).
+ *
+ * Not every basic generator supports every pattern (e.g., MT19937, Philox and ARS5 have no leapfrog); the VSL status
+ * is then thrown as std::runtime_error.
+ */
+class MKLStreamFamily {
+public:
+    enum class Method { MT2203_SET, SKIP_AHEAD, LEAPFROG };
+    static constexpr std::size_t MT2203_SET_SIZE = 6024;
+
+    MKLStreamFamily(MKL_INT brng, Method method, MKL_UINT seed, std::size_t n_streams, long long block_size = 0);
+    DELETE_COPY_MOVE(MKLStreamFamily)
+    ~MKLStreamFamily();
+
+    [[nodiscard]] VSLStreamStatePtr stream(std::size_t i) const { return streams_[i]; }
+    [[nodiscard]] std::size_t size() const { return streams_.size(); }
+    /**
+     * Fill @p out[0, @p n) with 32-bit words of stream @p i, by viRngUniformBits32.
+     */
+    void fill(std::size_t i, std::uint32_t* out, std::size_t n) const;
+
+private:
+    std::vector<VSLStreamStatePtr> streams_;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * NUMA topology and placement without libnuma, from /sys/devices/system/node and Linux system calls.
+ *
+ * Linux places a page on the node of the thread that first writes to it, so binding a thread to a node before it
+ * constructs an engine or fills a fresh buffer keeps both local to that node.
+ */
+
+struct NumaNode {
+    unsigned id;
+    std::vector<unsigned> cpus;
+};
+
+/**
+ * @param cpu_list A CPU list as in sysfs, e.g., "0-3,8-11".
+ * @return The CPUs listed, in order.
+ */
+std::vector<unsigned> parse_cpu_list(const std::string& cpu_list);
+
+/**
+ * @return The nodes with CPUs listed in /sys/devices/system/node, ordered by id, or a single node 0 with all CPUs if
+ * there is no such directory.
+ */
+std::vector<NumaNode> numa_nodes();
+
+/**
+ * Restrict the calling thread to @p cpus; throws std::system_error on failure.
+ */
+void bind_to_cpus(const std::vector<unsigned>& cpus);
+
+/**
+ * Write to every page of [@p data, @p data + @p n_bytes) so that they are placed on the node of the calling thread.
+ */
+void first_touch(void* data, std::size_t n_bytes);
+
+/**
+ * @return The node of the page holding @p address, which must have been touched, or -1 if unknown.
+ */
+int node_of(const void* address);
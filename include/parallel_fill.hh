@@ -0,0 +1,76 @@
+#pragma once
+
+#include "substreams.hh"
+#include "xoroshiro_wrapper.hh"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * Call @p fill_chunk(chunk, begin, end) for the @p n_threads contiguous chunks of [0, @p n), numbered from 0, on as
+ * many threads, the first on the calling one. Fewer chunks are made if @p n is smaller than @p n_threads.
+ */
+template <typename FillChunk>
+void parallel_for_chunks(const std::size_t n, std::size_t n_threads, FillChunk&& fill_chunk)
+{
+    n_threads = std::max<std::size_t>(1, std::min(n_threads, n));
+    std::vector<std::thread> workers {};
+    for (std::size_t t = 1; t < n_threads; ++t) {
+        workers.emplace_back(
+            [&fill_chunk, t, n, n_threads]() { fill_chunk(t, t * n / n_threads, (t + 1) * n / n_threads); });
+    }
+    fill_chunk(0, 0, n / n_threads);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * Fill @p out[0, n) with the next @p n outputs of @p engine, using @p n_threads threads, and advance @p engine past
+ * them.
+ *
+ * For engines with advance() (PCG, the Lehmer MCGs, SplitMix), where one step is one output: every thread copies the
+ * engine and advances it to the start of its chunk, so the result is exactly that of a sequential fill.
+ */
+template <typename Engine>
+void parallel_fill(Engine& engine, typename Engine::result_type* out, const std::size_t n, const std::size_t n_threads)
+{
+    using delta_type = typename SubstreamTraits<Engine>::delta_type;
+    parallel_for_chunks(
+        n, n_threads, [&engine, out](std::size_t /* chunk */, const std::size_t begin, const std::size_t end) {
+            Engine local = engine;
+            local.advance(static_cast<delta_type>(begin));
+            std::generate(out + begin, out + end, [&local]() { return local(); });
+        });
+    engine.advance(static_cast<delta_type>(n));
+}
+
+/**
+ * Fill @p out[0, n) from a xoshiro/xoroshiro generator whose logical stream is the concatenation of blocks of
+ * @p block_size outputs, block i being drawn from the state expanded from @p master_seed jumped i times.
+ *
+ * xoshiro cannot skip an arbitrary number of outputs, but the blocks do not depend on the number of threads, so the
+ * result equals that of a sequential fill of the same logical stream.
+ */
+template <typename Wrapper>
+void parallel_fill_blocks(const std::uint64_t master_seed, typename Wrapper::result_type* out, const std::size_t n,
+    const std::size_t n_threads, const std::size_t block_size = std::size_t { 1 } << 16)
+{
+    const std::size_t n_blocks = (n + block_size - 1) / block_size;
+    parallel_for_chunks(n_blocks, n_threads,
+        [=](std::size_t /* chunk */, const std::size_t first_block, const std::size_t last_block) {
+            typename Wrapper::state_type cursor = Wrapper::seeded_state(master_seed);
+            for (std::size_t b = 0; b < first_block; ++b) {
+                cursor.jump();
+            }
+            for (std::size_t b = first_block; b < last_block; ++b) {
+                Wrapper engine { cursor };
+                const std::size_t end = std::min(n, (b + 1) * block_size);
+                std::generate(out + b * block_size, out + end, [&engine]() { return engine(); });
+                cursor.jump();
+            }
+        });
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Quick statistical tests over a stream of 32-bit words, to reject obviously weak engines and adaptors in seconds
+ * before spending hours on TestU01 batteries. Passing them proves little; failing them settles the matter.
+ *
+ * Words are fed in blocks of any size with update(), so gigabytes go through a fixed amount of memory:
+ *   - byte chi-square: the 256 values of each of the 4 bytes of a word, per byte position;
+ *   - word chi-square: the 65,536 values of each 16-bit half of a word, per half;
+ *   - birthday spacings: duplicated spacings among BIRTHDAYS sorted words, Poisson with mean BIRTHDAYS^3 / 2^34 per
+ *     sample, on the first max_birthday_samples samples; its p-value is the smaller of the two tails;
+ *   - Hamming-weight dependency: the Hamming weights of non-overlapping pairs of words, each below, at or above 16,
+ *     against independent binomial weights;
+ *   - linear complexity: the linear complexity of blocks of LC_BLOCK_BITS of the lowest bit of the words, by
+ *     Berlekamp-Massey, classified as in NIST SP 800-22, on the first max_lc_blocks blocks.
+ */
+class Prescreen {
+public:
+    static constexpr std::size_t BIRTHDAYS = 4096;
+    static constexpr std::size_t LC_BLOCK_BITS = 512;
+    /** A test rejects when its p-value is below this or above 1 minus this. */
+    static constexpr double REJECT_P_VALUE = 1e-6;
+
+    struct Result {
+        std::string test;
+        double p_value;
+
+        [[nodiscard]] bool rejected() const { return p_value < REJECT_P_VALUE || p_value > 1 - REJECT_P_VALUE; }
+    };
+
+    explicit Prescreen(std::size_t max_birthday_samples = 1024, std::size_t max_lc_blocks = 4096);
+
+    void update(const std::uint32_t* words, std::size_t n);
+
+    /**
+     * @return The p-values of the tests that got enough words, in the order above.
+     */
+    [[nodiscard]] std::vector<Result> results() const;
+
+    [[nodiscard]] std::size_t n_words() const { return n_words_; }
+
+    /**
+     * Hamming weight of each of @p words[0, @p n) into @p weights, 16 (AVX-512) or 32 (AVX2) words at a time where
+     * available.
+     */
+    static void hamming_weights(const std::uint32_t* words, std::size_t n, std::uint8_t* weights);
+
+    /**
+     * Same as hamming_weights(), but without SIMD. Kept for benchmarking and as a fallback.
+     */
+    static void hamming_weights_scalar(const std::uint32_t* words, std::size_t n, std::uint8_t* weights);
+
+private:
+    static constexpr std::size_t LC_WORDS = LC_BLOCK_BITS / 64 + 1;
+
+    void update_birthdays(const std::uint32_t* words, std::size_t n);
+    void update_linear_complexity(const std::uint32_t* words, std::size_t n);
+    void end_lc_block();
+
+    std::size_t max_birthday_samples_;
+    std::size_t max_lc_blocks_;
+    std::size_t n_words_ = 0;
+
+    std::vector<std::uint64_t> byte_counts_ = std::vector<std::uint64_t>(4 * 256);
+    std::vector<std::uint64_t> half_counts_ = std::vector<std::uint64_t>(2 * 65536);
+
+    std::vector<std::uint32_t> birthdays_ {};
+    std::vector<std::uint32_t> birthday_scratch_ {};
+    std::size_t n_birthday_samples_ = 0;
+    std::uint64_t n_duplicate_spacings_ = 0;
+
+    std::vector<std::uint8_t> weights_ {};
+    bool has_pending_weight_ = false;
+    std::uint8_t pending_weight_ = 0;
+    std::array<std::uint64_t, 9> weight_pairs_ {};
+
+    // Bit i of lc_bits_[i / 64] is the lowest bit of word i of the current block.
+    std::array<std::uint64_t, LC_WORDS> lc_bits_ {};
+    std::size_t lc_position_ = 0;
+    std::size_t n_lc_blocks_ = 0;
+    std::array<std::uint64_t, 7> lc_classes_ {};
+};
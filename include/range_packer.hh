@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/**
+ * Pack the bits of an engine whose range [min, max] is not a full 32- or 64-bit word, e.g., minstd, ranlux24,
+ * knuth_b or GSL ranlux, into full words of @p Word, so that such engines can be benchmarked and tested with the
+ * others instead of being skipped.
+ *
+ * An output u = engine() - min is uniform over R = max - min + 1 values. If R is a power of 2, u gives log2(R) bits.
+ * Otherwise, with 2^k the largest power of 2 not above R, u is accepted as k bits if u < 2^k; a rejected u is still
+ * uniform over the R - 2^k other values, so it is tried again on that smaller range rather than discarded. Bits left
+ * over from one word start the next, so no accepted bit is wasted.
+ *
+ * The engine is held by reference and must outlive the packer; its min() and max() may be known only at run time.
+ */
+template <typename Engine, typename Word = std::uint32_t> class RangePacker {
+public:
+    using result_type = Word;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<Word>::max(); }
+
+    explicit RangePacker(Engine& engine)
+        : engine_ { engine }
+        , engine_min_ { static_cast<std::uint64_t>(engine.min()) }
+        , range_minus_1_ { static_cast<std::uint64_t>(engine.max()) - static_cast<std::uint64_t>(engine.min()) }
+    {
+    }
+
+    result_type operator()()
+    {
+        Word word = 0;
+        unsigned n_filled = 0;
+        while (n_filled < WORD_BITS) {
+            if (n_buffered_ == 0) {
+                refill();
+            }
+            const unsigned n_taken = std::min(WORD_BITS - n_filled, n_buffered_);
+            word |= static_cast<Word>(low_bits(buffer_, n_taken)) << n_filled;
+            buffer_ = n_taken == 64 ? 0 : buffer_ >> n_taken;
+            n_buffered_ -= n_taken;
+            n_filled += n_taken;
+        }
+        return word;
+    }
+
+    void fill(Word* out, const std::size_t n)
+    {
+        std::generate_n(out, n, [this]() { return (*this)(); });
+    }
+
+private:
+    static constexpr unsigned WORD_BITS = std::numeric_limits<Word>::digits;
+
+    static std::uint64_t low_bits(const std::uint64_t bits, const unsigned n)
+    {
+        return n == 64 ? bits : bits & ((std::uint64_t { 1 } << n) - 1);
+    }
+
+    /**
+     * Buffer the bits of the next accepted output, at least one.
+     */
+    void refill()
+    {
+        for (;;) {
+            std::uint64_t value = static_cast<std::uint64_t>(engine_()) - engine_min_;
+            if (range_minus_1_ == std::numeric_limits<std::uint64_t>::max()) {
+                buffer_ = value;
+                n_buffered_ = 64;
+                return;
+            }
+            // value is uniform over [0, size).
+            for (std::uint64_t size = range_minus_1_ + 1; size > 1;) {
+                const auto k = static_cast<unsigned>(63 - __builtin_clzll(size));
+                const std::uint64_t power = std::uint64_t { 1 } << k;
+                if (value < power) {
+                    buffer_ = value;
+                    n_buffered_ = k;
+                    return;
+                }
+                value -= power;
+                size -= power;
+            }
+        }
+    }
+
+    Engine& engine_;
+    std::uint64_t engine_min_;
+    std::uint64_t range_minus_1_;
+    std::uint64_t buffer_ = 0;
+    unsigned n_buffered_ = 0;
+};
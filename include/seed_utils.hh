@@ -0,0 +1,46 @@
+#pragma once
+
+#include <splitmix.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Drop-in replacement of std::seed_seq that expands one 64-bit seed with SplitMix64.
+ *
+ * Every 64-bit SplitMix64 output gives two 32-bit words, low half first. Unlike std::seed_seq, it allocates nothing
+ * and costs one mix per two words, so seeding MT19937's 624 words or a whole ARC4 box is cheap; unlike
+ * std::random_device, it makes no system call and is reproducible.
+ */
+class SplitMixSeedSeq {
+public:
+    using result_type = std::uint32_t;
+
+    explicit SplitMixSeedSeq(const std::uint64_t seed)
+        : seed_ { seed }
+    {
+    }
+
+    template <typename RandomIt> void generate(RandomIt begin, RandomIt end) const
+    {
+        splitmix64 expander { seed_ };
+        while (begin != end) {
+            const std::uint64_t bits = expander();
+            *begin++ = static_cast<result_type>(bits);
+            if (begin != end) {
+                *begin++ = static_cast<result_type>(bits >> 32);
+            }
+        }
+    }
+
+    [[nodiscard]] static constexpr std::size_t size() { return 2; }
+
+    template <typename OutputIt> void param(OutputIt out) const
+    {
+        *out++ = static_cast<result_type>(seed_);
+        *out = static_cast<result_type>(seed_ >> 32);
+    }
+
+private:
+    std::uint64_t seed_;
+};
@@ -2,6 +2,7 @@
 #include "class_utils.hh"
 
 #include <climits>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -26,6 +27,8 @@ public:
     SFMTBulkRandomDevice();
     ~SFMTBulkRandomDevice();
     void gen(std::vector<result_type>& vec);
+    // @p n must be a multiple of 4 of at least 624, and @p out 16-byte aligned.
+    void gen(result_type* out, std::size_t n);
 
 private:
     void* sfmt; // The actual type is sfmt_t, but we avoid including SFMT.h here
@@ -0,0 +1,85 @@
+#pragma once
+
+/*
+ * Single-producer single-consumer ring of 32-bit words in shared memory, written by bench_testu01 and read by
+ * testu01_main. Shared between C and C++, hence the GCC __atomic builtins instead of <atomic> or <stdatomic.h>.
+ *
+ * head and tail count words modulo 2^32 and index the data with capacity - 1, so the capacity is a power of 2 of at
+ * most 2^31. Each side sleeps on the other's counter with a futex, and only wakes the other side when it announced
+ * that it is waiting. Waits time out, so that the producer notices when the consumer exits.
+ */
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SHM_RING_DATA_OFFSET 4096
+#define SHM_RING_TIMEOUT_NS 100000000L
+
+struct shm_ring {
+    uint32_t capacity;
+    /* Set by the producer when it stops for good. */
+    uint32_t closed;
+    char pad0[56];
+    uint32_t head;
+    uint32_t consumer_waiting;
+    char pad1[56];
+    uint32_t tail;
+    uint32_t producer_waiting;
+    char pad2[56];
+};
+
+static inline size_t shm_ring_size(const uint32_t capacity)
+{
+    return SHM_RING_DATA_OFFSET + (size_t)capacity * sizeof(uint32_t);
+}
+
+static inline uint32_t* shm_ring_data(struct shm_ring* ring)
+{
+    return (uint32_t*)((char*)ring + SHM_RING_DATA_OFFSET);
+}
+
+static inline void shm_ring_wait(uint32_t* counter, const uint32_t observed)
+{
+    struct timespec timeout = { 0, SHM_RING_TIMEOUT_NS };
+    syscall(SYS_futex, counter, FUTEX_WAIT, observed, &timeout, NULL, 0);
+}
+
+static inline void shm_ring_wake(uint32_t* counter) { syscall(SYS_futex, counter, FUTEX_WAKE, INT_MAX, NULL, NULL, 0); }
+
+/*
+ * Publish the new value of @p counter and wake the other side if it waits for it.
+ */
+static inline void shm_ring_publish(uint32_t* counter, const uint32_t value, uint32_t* other_waiting)
+{
+    __atomic_store_n(counter, value, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(other_waiting, __ATOMIC_SEQ_CST) != 0) {
+        shm_ring_wake(counter);
+    }
+}
+
+/*
+ * Wait at most one timeout for @p counter to differ from @p observed.
+ *
+ * @return The current value of @p counter.
+ */
+static inline uint32_t shm_ring_await_change(uint32_t* counter, const uint32_t observed, uint32_t* waiting)
+{
+    uint32_t value = __atomic_load_n(counter, __ATOMIC_ACQUIRE);
+    if (value != observed) {
+        return value;
+    }
+    __atomic_store_n(waiting, 1, __ATOMIC_SEQ_CST);
+    value = __atomic_load_n(counter, __ATOMIC_SEQ_CST);
+    if (value == observed) {
+        shm_ring_wait(counter, observed);
+        value = __atomic_load_n(counter, __ATOMIC_ACQUIRE);
+    }
+    __atomic_store_n(waiting, 0, __ATOMIC_SEQ_CST);
+    return value;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "class_utils.hh"
+#include "substreams.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * Engine returning the outputs of K streams of @p Engine in turn, one output of each stream per round.
+ *
+ * A battery run on the interleaved output sees the streams side by side as parallel workers would draw them, so
+ * correlations between streams of a seeding scheme show up as defects of a single sequence.
+ */
+template <typename Engine> class StreamInterleaver {
+public:
+    using result_type = typename Engine::result_type;
+
+    explicit StreamInterleaver(std::vector<std::unique_ptr<Engine>> streams)
+        : streams_ { std::move(streams) }
+    {
+    }
+    DELETE_COPY_MOVE(StreamInterleaver)
+    ~StreamInterleaver() = default;
+
+    result_type operator()()
+    {
+        const result_type value = (*streams_[next_])();
+        next_ = next_ + 1 == streams_.size() ? 0 : next_ + 1;
+        return value;
+    }
+    // Static, as std::uniform_int_distribution checks the range at compile time.
+    static constexpr result_type min() { return Engine::min(); }
+    static constexpr result_type max() { return Engine::max(); }
+
+    [[nodiscard]] std::size_t n_streams() const { return streams_.size(); }
+
+private:
+    std::vector<std::unique_ptr<Engine>> streams_;
+    std::size_t next_ = 0;
+};
+
+/**
+ * @p n_streams engines made by @p make_engine from the adjacent seeds @p seed, @p seed + 1, ..., as when each worker
+ * seeds its engine with a base seed plus its index.
+ */
+template <typename Engine>
+std::vector<std::unique_ptr<Engine>> adjacent_seed_streams(
+    const std::function<std::unique_ptr<Engine>(std::uint64_t)>& make_engine, const std::uint64_t seed,
+    const std::size_t n_streams)
+{
+    std::vector<std::unique_ptr<Engine>> streams {};
+    streams.reserve(n_streams);
+    for (std::size_t i = 0; i < n_streams; ++i) {
+        streams.emplace_back(make_engine(seed + i));
+    }
+    return streams;
+}
+
+/**
+ * @p n_streams engines with the same @p seed and the streams 0, 1, ... selected by set_stream(), as PCG offers.
+ */
+template <typename Engine>
+std::vector<std::unique_ptr<Engine>> set_stream_streams(const std::uint64_t seed, const std::size_t n_streams)
+{
+    std::vector<std::unique_ptr<Engine>> streams {};
+    streams.reserve(n_streams);
+    for (std::size_t i = 0; i < n_streams; ++i) {
+        auto engine = std::make_unique<Engine>(static_cast<typename Engine::state_type>(seed));
+        engine->set_stream(static_cast<typename Engine::state_type>(i));
+        streams.emplace_back(std::move(engine));
+    }
+    return streams;
+}
+
+/**
+ * @p n_streams engines at the disjoint blocks of the period given by split(), each advanced from the previous one.
+ */
+template <typename Engine>
+std::vector<std::unique_ptr<Engine>> advanced_streams(const Engine& base, const std::size_t n_streams)
+{
+    std::vector<std::unique_ptr<Engine>> streams {};
+    streams.reserve(n_streams);
+    for (auto& engine : split(base, n_streams)) {
+        streams.emplace_back(std::make_unique<Engine>(std::move(engine)));
+    }
+    return streams;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <lehmer.hpp>
+#include <splitmix.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Jump-ahead parameters of an engine with an O(log n) or O(1) advance(delta).
+ *
+ * PCG engines and the Lehmer MCGs of lehmer.hpp expose state_type and period_pow2(); SplitMix advances its Weyl
+ * counter by delta * gamma, so its period is 2^64 whatever the gamma.
+ */
+template <typename Engine> struct SubstreamTraits {
+    using delta_type = typename Engine::state_type;
+    static constexpr std::size_t period_pow2 = Engine::period_pow2();
+};
+
+template <> struct SubstreamTraits<splitmix64> {
+    using delta_type = std::uint64_t;
+    static constexpr std::size_t period_pow2 = 64;
+};
+
+template <> struct SubstreamTraits<splitmix32> {
+    using delta_type = std::uint64_t;
+    static constexpr std::size_t period_pow2 = 64;
+};
+
+/**
+ * Length of each of @p n_substreams equal blocks of the period: the largest power of 2 with at least that many blocks.
+ */
+template <typename Engine> typename SubstreamTraits<Engine>::delta_type substream_length(const std::size_t n_substreams)
+{
+    using Traits = SubstreamTraits<Engine>;
+    static_assert(Traits::period_pow2 <= 8 * sizeof(typename Traits::delta_type),
+        "Engines with extended periods cannot be split by block");
+    std::size_t log2_n = 0;
+    while ((std::size_t { 1 } << log2_n) < n_substreams) {
+        ++log2_n;
+    }
+    // For a single substream the block would be the whole period, which may not fit into delta_type.
+    return log2_n == 0 ? ~typename Traits::delta_type { 0 }
+                       : typename Traits::delta_type { 1 } << (Traits::period_pow2 - log2_n);
+}
+
+/**
+ * Substream @p index out of @p n_substreams disjoint blocks of the period of @p base, with one O(log n) advance.
+ *
+ * Use it when every task jumps to its own block; split() is cheaper when all substreams are needed at once.
+ */
+template <typename Engine> Engine substream(const Engine& base, const std::size_t index, const std::size_t n_substreams)
+{
+    Engine engine = base;
+    engine.advance(static_cast<typename SubstreamTraits<Engine>::delta_type>(index)
+        * substream_length<Engine>(n_substreams));
+    return engine;
+}
+
+/**
+ * Split @p base into @p n_substreams engines drawing from disjoint blocks of its period.
+ *
+ * The first engine is a copy of @p base. PCG engines with selectable streams are split by block as well, as distinct
+ * streams of one PCG are not guaranteed to be uncorrelated.
+ */
+template <typename Engine> std::vector<Engine> split(const Engine& base, const std::size_t n_substreams)
+{
+    const auto length = substream_length<Engine>(n_substreams);
+    std::vector<Engine> substreams {};
+    substreams.reserve(n_substreams);
+    Engine cursor = base;
+    for (std::size_t i = 0; i < n_substreams; ++i) {
+        substreams.emplace_back(cursor);
+        cursor.advance(length);
+    }
+    return substreams;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+/*
+ * Selection of a TestU01 battery, or of one of its tests, by name. Shared by testu01_main and the in-process mode of
+ * bench_testu01.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <TestU01.h>
+#ifdef __cplusplus
+}
+#endif
+
+#include <string.h>
+
+#define TESTU01_MAX_TESTS 106
+/* Bits given to Rabbit and Alphabit by default, as TestU01 leaves it to the user. */
+#define TESTU01_DEFAULT_N_BITS 1073741824.0
+
+struct testu01_battery {
+    const char* name;
+    int n_tests;
+};
+
+static const struct testu01_battery TESTU01_BATTERIES[] = { { "SmallCrush", 10 }, { "Crush", 96 },
+    { "BigCrush", TESTU01_MAX_TESTS }, { "Rabbit", 26 }, { "Alphabit", 9 } };
+
+/*
+ * @return The number of tests of @p battery, or -1 if there is no such battery.
+ */
+static inline int testu01_n_tests(const char* battery)
+{
+    for (size_t i = 0; i < sizeof(TESTU01_BATTERIES) / sizeof(TESTU01_BATTERIES[0]); i++) {
+        if (strcmp(battery, TESTU01_BATTERIES[i].name) == 0) {
+            return TESTU01_BATTERIES[i].n_tests;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Run @p battery on @p gen, or only its test number @p test (from 1) if positive, through bbattery_Repeat*(). Rabbit
+ * and Alphabit look at @p n_bits bits; Alphabit takes all 32 bits of each word.
+ *
+ * @return 0, or -1 if there is no such battery or test.
+ */
+static inline int testu01_run_battery(unif01_Gen* gen, const char* battery, const int test, const double n_bits)
+{
+    int rep[TESTU01_MAX_TESTS + 1] = { 0 };
+    const int n_tests = testu01_n_tests(battery);
+    if (n_tests < 0 || test < 0 || test > n_tests) {
+        return -1;
+    }
+    if (test > 0) {
+        rep[test] = 1;
+    }
+    if (strcmp(battery, "SmallCrush") == 0) {
+        if (test > 0) {
+            bbattery_RepeatSmallCrush(gen, rep);
+        } else {
+            bbattery_SmallCrush(gen);
+        }
+    } else if (strcmp(battery, "Crush") == 0) {
+        if (test > 0) {
+            bbattery_RepeatCrush(gen, rep);
+        } else {
+            bbattery_Crush(gen);
+        }
+    } else if (strcmp(battery, "BigCrush") == 0) {
+        if (test > 0) {
+            bbattery_RepeatBigCrush(gen, rep);
+        } else {
+            bbattery_BigCrush(gen);
+        }
+    } else if (strcmp(battery, "Rabbit") == 0) {
+        if (test > 0) {
+            bbattery_RepeatRabbit(gen, n_bits, rep);
+        } else {
+            bbattery_Rabbit(gen, n_bits);
+        }
+    } else {
+        if (test > 0) {
+            bbattery_RepeatAlphabit(gen, n_bits, 0, 32, rep);
+        } else {
+            bbattery_Alphabit(gen, n_bits, 0, 32);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * Structured results of TestU01 batteries, parsed from their summaries and kept in a CSV file so that reruns can skip
+ * the combinations already tested.
+ *
+ * The summary of a battery only lists the statistics with a p-value outside [0.001, 0.999], so a result is one record
+ * per such statistic, and a last record, with test 0 and name TESTU01_ALL_OTHER, for all the statistics that passed,
+ * if any.
+ */
+
+/**
+ * What a result depends on. @p battery is the label of the run, e.g., "Crush test 12".
+ */
+struct TestU01Key {
+    std::string generator;
+    std::string version;
+    std::uint64_t seed;
+    std::string adaptor;
+    std::string battery;
+
+    bool operator<(const TestU01Key& other) const;
+};
+
+struct TestU01Record {
+    /** From 1, in the numbering of the battery; 0 for the record of all other statistics. */
+    int test;
+    /** Test and statistic as printed by TestU01, e.g., "MaxOft AD, t = 5". */
+    std::string name;
+    /**
+     * As printed by TestU01, e.g., "eps", "1 - eps1" or "3.6e-4", with one space after "1 -"; empty for the record of
+     * all other statistics.
+     */
+    std::string p_value;
+    bool passed;
+};
+
+inline const std::string TESTU01_ALL_OTHER = "(all other)";
+
+/**
+ * @return The summary records of the battery reported in @p output, or nothing if it has no complete summary, e.g.,
+ * because TestU01 crashed.
+ */
+std::optional<std::vector<TestU01Record>> parse_testu01_summary(const std::string& output);
+
+/**
+ * @return @p records as a table in the format of TestU01 summaries.
+ */
+std::string format_testu01_records(const std::vector<TestU01Record>& records);
+
+/**
+ * Results by key, loaded from and saved to a CSV file with one line per record. Not thread-safe.
+ */
+class TestU01ResultStore {
+public:
+    /**
+     * Load @p path if it exists; throws std::runtime_error if it is malformed.
+     */
+    explicit TestU01ResultStore(std::string path);
+
+    /**
+     * @return The records of @p key, or nullptr if it was not tested.
+     */
+    [[nodiscard]] const std::vector<TestU01Record>* find(const TestU01Key& key) const;
+    void put(const TestU01Key& key, std::vector<TestU01Record> records);
+
+    /**
+     * Replace the file by the content of the store at once, so that it is never left half-written.
+     */
+    void save() const;
+
+private:
+    std::string path_;
+    std::map<TestU01Key, std::vector<TestU01Record>> results_;
+};
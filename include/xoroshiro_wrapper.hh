@@ -1,11 +1,19 @@
 #pragma once
 #include "class_utils.hh"
 
+#include <splitmix.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <random>
+#include <type_traits>
+#include <vector>
 
 template <typename xoroshiro_type, typename result_type_, int num_states = 2> class XoroshiroWrapper {
 public:
     using result_type = result_type_;
+    using state_type = xoroshiro_type;
     XoroshiroWrapper()
     {
         std::random_device rd;
@@ -13,11 +21,92 @@ public:
             xoroshiro_impl_.s[i] = rd();
         }
     }
+    explicit XoroshiroWrapper(const state_type& state)
+        : xoroshiro_impl_ { state }
+    {
+    }
     DELETE_COPY_MOVE(XoroshiroWrapper)
     ~XoroshiroWrapper() = default;
     result_type operator()() { return xoroshiro_impl_.next(); }
     SPAN_RESULT_TYPE
 
+    /**
+     * Expand one 64-bit seed to a full state with SplitMix64, as recommended by Vigna.
+     *
+     * Consecutive SplitMix64 outputs are distinct, so a state of 64-bit words is never all zero; for 32-bit words the
+     * chance is negligible.
+     */
+    static state_type seeded_state(const std::uint64_t master_seed)
+    {
+        splitmix64 expander { master_seed };
+        state_type state {};
+        for (int i = 0; i < num_states; ++i) {
+            state.s[i] = static_cast<std::remove_reference_t<decltype(state.s[0])>>(expander());
+        }
+        return state;
+    }
+
+    /** Only for the generators that define them; see vigna.h for the length of the jumps. */
+    void jump() { xoroshiro_impl_.jump(); }
+    void long_jump() { xoroshiro_impl_.long_jump(); }
+
 private:
     xoroshiro_type xoroshiro_impl_ {};
 };
+
+/**
+ * Hand out non-overlapping streams of one xoroshiro/xoshiro generator from a single master seed.
+ *
+ * Stream i starts i jumps after the state expanded from the master seed, so the same seed always gives the same
+ * streams, and no two streams overlap unless one of them is drawn for more than the jump length (2^64 for the 32-bit
+ * generators, 2^128 or more for the 64-bit ones).
+ */
+template <typename Wrapper> class XoroshiroStreamFactory {
+public:
+    using state_type = typename Wrapper::state_type;
+
+    explicit XoroshiroStreamFactory(const std::uint64_t master_seed)
+        : next_state_ { Wrapper::seeded_state(master_seed) }
+    {
+    }
+    DELETE_COPY_MOVE(XoroshiroStreamFactory)
+    ~XoroshiroStreamFactory() = default;
+
+    std::unique_ptr<Wrapper> next_stream()
+    {
+        auto stream = std::make_unique<Wrapper>(next_state_);
+        next_state_.jump();
+        return stream;
+    }
+
+    std::vector<std::unique_ptr<Wrapper>> make_streams(const std::size_t n_streams)
+    {
+        std::vector<std::unique_ptr<Wrapper>> streams {};
+        streams.reserve(n_streams);
+        for (std::size_t i = 0; i < n_streams; ++i) {
+            streams.emplace_back(next_stream());
+        }
+        return streams;
+    }
+
+private:
+    state_type next_state_;
+};
+
+/**
+ * States of @p n_streams streams, successive jumps apart from the state expanded from @p master_seed.
+ *
+ * Same streams as XoroshiroStreamFactory, as plain states for containers of engines.
+ */
+template <typename Wrapper>
+std::vector<typename Wrapper::state_type> jumped_states(const std::uint64_t master_seed, const std::size_t n_streams)
+{
+    std::vector<typename Wrapper::state_type> states {};
+    states.reserve(n_streams);
+    typename Wrapper::state_type cursor = Wrapper::seeded_state(master_seed);
+    for (std::size_t i = 0; i < n_streams; ++i) {
+        states.emplace_back(cursor);
+        cursor.jump();
+    }
+    return states;
+}
@@ -0,0 +1,62 @@
+#include "alias_table.hh"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+std::uint32_t to_threshold(const double probability)
+{
+    // Columns that are (numerically) full alias to themselves, so the clamped threshold is harmless.
+    if (probability >= 1.0) {
+        return std::numeric_limits<std::uint32_t>::max();
+    }
+    if (probability <= 0.0) {
+        return 0;
+    }
+    return static_cast<std::uint32_t>(std::ldexp(probability, 32));
+}
+} // namespace
+
+AliasTable::AliasTable(const std::vector<double>& weights)
+    : entries_(weights.size())
+{
+    const std::size_t n = weights.size();
+    const double sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    if (n == 0 || n > std::numeric_limits<std::uint32_t>::max() || !(sum > 0.0)) {
+        throw std::invalid_argument("AliasTable: weights should be non-empty with a positive sum");
+    }
+
+    std::vector<double> scaled(n);
+    std::vector<std::uint32_t> small {};
+    std::vector<std::uint32_t> large {};
+    small.reserve(n);
+    large.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        scaled[i] = weights[i] * static_cast<double>(n) / sum;
+        (scaled[i] < 1.0 ? small : large).emplace_back(static_cast<std::uint32_t>(i));
+    }
+
+    while (!small.empty() && !large.empty()) {
+        const std::uint32_t s = small.back();
+        small.pop_back();
+        const std::uint32_t l = large.back();
+        entries_[s] = { to_threshold(scaled[s]), l };
+        scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+        if (scaled[l] < 1.0) {
+            large.pop_back();
+            small.emplace_back(l);
+        }
+    }
+    // Whatever is left over is 1 up to rounding error.
+    for (const auto i : large) {
+        entries_[i] = { std::numeric_limits<std::uint32_t>::max(), i };
+    }
+    for (const auto i : small) {
+        entries_[i] = { std::numeric_limits<std::uint32_t>::max(), i };
+    }
+}
@@ -1,6 +1,8 @@
 #include "benchmark_utils.hh"
 
+#include <algorithm>
 #include <sstream>
+#include <thread>
 
 std::string describe(const std::vector<std::size_t>& times)
 {
@@ -10,3 +12,13 @@ std::string describe(const std::vector<std::size_t>& times)
         << formatWithCommas(mean_) + "/" + formatWithCommas(sd(times, mean_));
     return oss.str();
 }
+
+std::vector<std::size_t> thread_counts()
+{
+    const std::size_t max_threads = std::max<std::size_t>(4, std::thread::hardware_concurrency());
+    std::vector<std::size_t> counts {};
+    for (std::size_t n = 1; n <= max_threads; n *= 2) {
+        counts.emplace_back(n);
+    }
+    return counts;
+}
@@ -0,0 +1,106 @@
+#include "block_scheduler.hh"
+
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(const std::size_t n_threads)
+{
+    const std::size_t n_workers = std::max<std::size_t>(1, n_threads);
+    for (std::size_t i = 0; i < n_workers; ++i) {
+        queues_.emplace_back(std::make_unique<TaskQueue>());
+    }
+    for (std::size_t i = 0; i < n_workers; ++i) {
+        workers_.emplace_back([this, i]() { work(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock { mutex_ };
+        stopping_ = true;
+    }
+    start_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::run(const std::size_t n_tasks, const std::function<void(std::size_t)>& task)
+{
+    if (n_tasks == 0) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock { mutex_ };
+    // Published before any index is queued, so whoever pops an index of this batch sees its task.
+    task_.store(&task, std::memory_order_release);
+    error_ = nullptr;
+    pending_ = n_tasks;
+    const std::size_t n_workers = queues_.size();
+    for (std::size_t i = 0; i < n_workers; ++i) {
+        std::lock_guard<std::mutex> queue_lock { queues_[i]->mutex };
+        for (std::size_t t = i * n_tasks / n_workers; t < (i + 1) * n_tasks / n_workers; ++t) {
+            queues_[i]->tasks.emplace_back(t);
+        }
+    }
+    ++generation_;
+    start_.notify_all();
+    done_.wait(lock, [this]() { return pending_ == 0; });
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+bool WorkStealingPool::pop_or_steal(const std::size_t worker_id, std::size_t& task_id)
+{
+    {
+        TaskQueue& own = *queues_[worker_id];
+        std::lock_guard<std::mutex> lock { own.mutex };
+        if (!own.tasks.empty()) {
+            task_id = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    const std::size_t n_workers = queues_.size();
+    for (std::size_t offset = 1; offset < n_workers; ++offset) {
+        TaskQueue& victim = *queues_[(worker_id + offset) % n_workers];
+        std::lock_guard<std::mutex> lock { victim.mutex };
+        if (!victim.tasks.empty()) {
+            task_id = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::work(const std::size_t worker_id)
+{
+    std::uint64_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock { mutex_ };
+            start_.wait(lock, [this, seen_generation]() { return stopping_ || generation_ != seen_generation; });
+            if (stopping_) {
+                return;
+            }
+            seen_generation = generation_;
+        }
+        std::size_t task_id = 0;
+        while (pop_or_steal(worker_id, task_id)) {
+            try {
+                (*task_.load(std::memory_order_acquire))(task_id);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock { mutex_ };
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+            if (--pending_ == 0) {
+                // Taking the lock orders this notification after run() started waiting.
+                std::lock_guard<std::mutex> lock { mutex_ };
+                done_.notify_all();
+            }
+        }
+    }
+}
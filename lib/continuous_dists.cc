@@ -0,0 +1,132 @@
+#include "continuous_dists.hh"
+
+#include "arch_utils.hh"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(BENCH_RAND_ARCH_X86) && defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+// Coefficients and split ln(2) of fdlibm's e_log.c.
+constexpr double LN2_HI = 6.93147180369123816490e-01;
+constexpr double LN2_LO = 1.90821492927058770002e-10;
+constexpr double LG1 = 6.666666666666735130e-01;
+constexpr double LG2 = 3.999999999940941908e-01;
+constexpr double LG3 = 2.857142874366239149e-01;
+constexpr double LG4 = 2.222219843214978396e-01;
+constexpr double LG5 = 1.818357216161805012e-01;
+constexpr double LG6 = 1.531383769920937332e-01;
+constexpr double LG7 = 1.479819860511658591e-01;
+constexpr double SQRT2 = 1.41421356237309504880;
+constexpr std::uint64_t MANTISSA_MASK = 0x000FFFFFFFFFFFFFULL;
+constexpr std::uint64_t EXPONENT_ONE = 0x3FF0000000000000ULL;
+
+double log_scalar(const double x)
+{
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &x, sizeof(bits));
+    auto k = static_cast<double>(static_cast<std::int64_t>(bits >> 52) - 1023);
+    bits = (bits & MANTISSA_MASK) | EXPONENT_ONE;
+    double m = 0.0;
+    std::memcpy(&m, &bits, sizeof(m));
+    // Reduce to m in [sqrt(2) / 2, sqrt(2)).
+    if (m > SQRT2) {
+        m *= 0.5;
+        k += 1.0;
+    }
+    const double f = m - 1.0;
+    const double s = f / (2.0 + f);
+    const double z = s * s;
+    const double w = z * z;
+    const double t1 = w * (LG2 + w * (LG4 + w * LG6));
+    const double t2 = z * (LG1 + w * (LG3 + w * (LG5 + w * LG7)));
+    const double hfsq = 0.5 * f * f;
+    return k * LN2_HI - ((hfsq - (s * (hfsq + t1 + t2) + k * LN2_LO)) - f);
+}
+
+#if defined(BENCH_RAND_ARCH_X86) && defined(__AVX2__)
+__m256d log_avx2(const __m256d x)
+{
+    const __m256i bits = _mm256_castpd_si256(x);
+    // The biased exponent is turned into a double by planting it into the mantissa of 2^52.
+    const __m256i two52_bits = _mm256_set1_epi64x(0x4330000000000000LL);
+    const __m256d biased_k = _mm256_sub_pd(
+        _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(bits, 52), two52_bits)), _mm256_set1_pd(0x1.0p52));
+    __m256d k = _mm256_sub_pd(biased_k, _mm256_set1_pd(1023.0));
+    __m256d m = _mm256_castsi256_pd(_mm256_or_si256(
+        _mm256_and_si256(bits, _mm256_set1_epi64x(static_cast<long long>(MANTISSA_MASK))),
+        _mm256_set1_epi64x(static_cast<long long>(EXPONENT_ONE))));
+    const __m256d big = _mm256_cmp_pd(m, _mm256_set1_pd(SQRT2), _CMP_GT_OQ);
+    m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), big);
+    k = _mm256_add_pd(k, _mm256_and_pd(big, _mm256_set1_pd(1.0)));
+
+    const __m256d f = _mm256_sub_pd(m, _mm256_set1_pd(1.0));
+    const __m256d s = _mm256_div_pd(f, _mm256_add_pd(_mm256_set1_pd(2.0), f));
+    const __m256d z = _mm256_mul_pd(s, s);
+    const __m256d w = _mm256_mul_pd(z, z);
+    const auto madd = [](const __m256d a, const __m256d b, const double c) {
+        return _mm256_add_pd(_mm256_set1_pd(c), _mm256_mul_pd(a, b));
+    };
+    const __m256d t1 = _mm256_mul_pd(w, madd(w, madd(w, _mm256_set1_pd(LG6), LG4), LG2));
+    const __m256d t2 = _mm256_mul_pd(z, madd(w, madd(w, madd(w, _mm256_set1_pd(LG7), LG5), LG3), LG1));
+    const __m256d hfsq = _mm256_mul_pd(_mm256_set1_pd(0.5), _mm256_mul_pd(f, f));
+    const __m256d r = _mm256_add_pd(
+        _mm256_mul_pd(s, _mm256_add_pd(hfsq, _mm256_add_pd(t1, t2))), _mm256_mul_pd(k, _mm256_set1_pd(LN2_LO)));
+    return _mm256_sub_pd(
+        _mm256_mul_pd(k, _mm256_set1_pd(LN2_HI)), _mm256_sub_pd(_mm256_sub_pd(hfsq, r), f));
+}
+#endif
+} // namespace
+
+void vlog(const double* in, double* out, const std::size_t n)
+{
+    std::size_t i = 0;
+#if defined(BENCH_RAND_ARCH_X86) && defined(__AVX2__)
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(out + i, log_avx2(_mm256_loadu_pd(in + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = log_scalar(in[i]);
+    }
+}
+
+ZigguratExponential::ZigguratExponential()
+{
+    constexpr double M = 0x1.0p53;
+    double de = R;
+    double te = R;
+    const double q = V / std::exp(-de);
+    k_[0] = static_cast<std::uint64_t>((de / q) * M);
+    k_[1] = 0;
+    w_[0] = q / M;
+    w_[255] = de / M;
+    f_[0] = 1.0;
+    f_[255] = std::exp(-de);
+    for (int i = 254; i >= 1; --i) {
+        de = -std::log(V / de + std::exp(-de));
+        k_[i + 1] = static_cast<std::uint64_t>((de / te) * M);
+        te = de;
+        f_[i] = std::exp(-de);
+        w_[i] = de / M;
+    }
+}
+
+GammaSampler::GammaSampler(const double shape, const double scale)
+    : scale_(scale)
+    , inv_shape_(1.0 / shape)
+    , boost_(shape < 1.0)
+    , d_((shape < 1.0 ? shape + 1.0 : shape) - 1.0 / 3.0)
+    , c_(1.0 / std::sqrt(9.0 * d_))
+{
+    // Written so that NaN is rejected too; a shape of -2/3 or less would make fill() loop forever.
+    if (!(shape > 0.0) || !(scale > 0.0)) {
+        throw std::invalid_argument("GammaSampler: shape and scale should be positive");
+    }
+}
@@ -0,0 +1,79 @@
+#include "error_mask.hh"
+
+#include "arch_utils.hh"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if defined(BENCH_RAND_ARCH_X86) && defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+ErrorMaskKernel::ErrorMaskKernel(const int qual_offset)
+{
+    for (int q = 0; q < 256; ++q) {
+        const int phred = q < qual_offset ? 0 : q - qual_offset;
+        const double threshold = std::ldexp(std::pow(10.0, -phred / 10.0), 32);
+        thresholds_[q] = threshold >= std::ldexp(1.0, 32) ? std::numeric_limits<std::uint32_t>::max()
+                                                          : static_cast<std::uint32_t>(threshold);
+    }
+}
+
+void ErrorMaskKernel::apply_scalar(
+    const std::uint8_t* quals, const std::uint32_t* bits, const std::size_t n, std::uint64_t* mask) const
+{
+    for (std::size_t begin = 0; begin < n; begin += 64) {
+        const std::size_t end = n - begin < 64 ? n : begin + 64;
+        std::uint64_t word = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            word |= static_cast<std::uint64_t>(bits[i] < thresholds_[quals[i]]) << (i - begin);
+        }
+        mask[begin / 64] = word;
+    }
+}
+
+void ErrorMaskKernel::apply(
+    const std::uint8_t* quals, const std::uint32_t* bits, const std::size_t n, std::uint64_t* mask) const
+{
+#if defined(BENCH_RAND_ARCH_X86) && defined(__AVX512F__)
+    // The masked forms are used as the unmasked ones trigger -Wmaybe-uninitialized in GCC's own headers.
+    const auto* table = reinterpret_cast<const int*>(thresholds_);
+    constexpr __mmask16 ALL_LANES = 0xFFFF;
+    std::size_t begin = 0;
+    for (; begin + 64 <= n; begin += 64) {
+        std::uint64_t word = 0;
+        for (std::size_t lane = 0; lane < 64; lane += 16) {
+            const __m512i idx = _mm512_maskz_cvtepu8_epi32(
+                ALL_LANES, _mm_loadu_si128(reinterpret_cast<const __m128i*>(quals + begin + lane)));
+            const __m512i thr = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), ALL_LANES, idx, table, 4);
+            const __m512i rnd = _mm512_loadu_si512(bits + begin + lane);
+            word |= static_cast<std::uint64_t>(_mm512_cmplt_epu32_mask(rnd, thr)) << lane;
+        }
+        mask[begin / 64] = word;
+    }
+    apply_scalar(quals + begin, bits + begin, n - begin, mask + begin / 64);
+#elif defined(BENCH_RAND_ARCH_X86) && defined(__AVX2__)
+    // AVX2 has no unsigned comparison, so both sides are shifted into the signed range first.
+    const auto* table = reinterpret_cast<const int*>(thresholds_);
+    const __m256i sign = _mm256_set1_epi32(std::numeric_limits<std::int32_t>::min());
+    std::size_t begin = 0;
+    for (; begin + 64 <= n; begin += 64) {
+        std::uint64_t word = 0;
+        for (std::size_t lane = 0; lane < 64; lane += 8) {
+            const __m256i idx
+                = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(quals + begin + lane)));
+            const __m256i thr = _mm256_xor_si256(_mm256_i32gather_epi32(table, idx, 4), sign);
+            const __m256i rnd
+                = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits + begin + lane)), sign);
+            const int lt = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(thr, rnd)));
+            word |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(lt)) << lane;
+        }
+        mask[begin / 64] = word;
+    }
+    apply_scalar(quals + begin, bits + begin, n - begin, mask + begin / 64);
+#else
+    apply_scalar(quals, bits, n, mask);
+#endif
+}
@@ -0,0 +1,14 @@
+#include "geometric_skip.hh"
+
+#include <cmath>
+#include <limits>
+
+GeometricSkipSampler::GeometricSkipSampler(const int qual_offset)
+{
+    for (int q = 0; q < 256; ++q) {
+        const int phred = q < qual_offset ? 0 : q - qual_offset;
+        // Q0 mutates for sure, which is an infinite hazard: every base is an event.
+        hazards_[q] = phred == 0 ? std::numeric_limits<double>::infinity()
+                                 : -std::log1p(-std::pow(10.0, -phred / 10.0));
+    }
+}
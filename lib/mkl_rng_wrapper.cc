@@ -2,6 +2,20 @@
 
 #include <mkl.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace {
+void check_status(const int status, const std::string& what)
+{
+    if (status != VSL_STATUS_OK) {
+        throw std::runtime_error(what + " failed with VSL status " + std::to_string(status));
+    }
+}
+} // namespace
+
 MKLRNGWrapper::MKLRNGWrapper(const MKL_INT type, const MKL_UINT seed)
 {
     vslNewStream(&stream_, type, seed);
@@ -20,3 +34,46 @@ MKLRNGWrapper::result_type MKLRNGWrapper::operator()()
 }
 MKLRNGWrapper::result_type MKLRNGWrapper::min() const { return min_; }
 MKLRNGWrapper::result_type MKLRNGWrapper::max() const { return max_; }
+
+MKLStreamFamily::MKLStreamFamily(const MKL_INT brng, const Method method, const MKL_UINT seed,
+    const std::size_t n_streams, const long long block_size)
+{
+    if (method == Method::MT2203_SET && n_streams > MT2203_SET_SIZE) {
+        throw std::invalid_argument("MT2203 has only 6024 parameter sets");
+    }
+    streams_.reserve(n_streams);
+    try {
+        for (std::size_t i = 0; i < n_streams; ++i) {
+            VSLStreamStatePtr stream = nullptr;
+            const MKL_INT this_brng = method == Method::MT2203_SET ? VSL_BRNG_MT2203 + static_cast<MKL_INT>(i) : brng;
+            check_status(vslNewStream(&stream, this_brng, seed), "vslNewStream");
+            streams_.emplace_back(stream);
+            if (method == Method::SKIP_AHEAD) {
+                check_status(vslSkipAheadStream(stream, static_cast<long long>(i) * block_size), "vslSkipAheadStream");
+            } else if (method == Method::LEAPFROG) {
+                check_status(vslLeapfrogStream(stream, static_cast<MKL_INT>(i), static_cast<MKL_INT>(n_streams)),
+                    "vslLeapfrogStream");
+            }
+        }
+    } catch (...) {
+        for (auto& stream : streams_) {
+            vslDeleteStream(&stream);
+        }
+        throw;
+    }
+}
+
+MKLStreamFamily::~MKLStreamFamily()
+{
+    for (auto& stream : streams_) {
+        vslDeleteStream(&stream);
+    }
+}
+
+void MKLStreamFamily::fill(const std::size_t i, std::uint32_t* out, const std::size_t n) const
+{
+    // Not viRngUniformBits, which writes 64-bit words for 64-bit generators such as MCG59.
+    check_status(viRngUniformBits32(VSL_RNG_METHOD_UNIFORMBITS32_STD, streams_[i], static_cast<MKL_INT>(n),
+                     reinterpret_cast<unsigned int*>(out)),
+        "viRngUniformBits32");
+}
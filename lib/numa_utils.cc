@@ -0,0 +1,108 @@
+#include "numa_utils.hh"
+
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const std::filesystem::path NODE_DIR { "/sys/devices/system/node" };
+
+// From <numaif.h>, which comes with libnuma.
+constexpr unsigned long MPOL_F_NODE = 1;
+constexpr unsigned long MPOL_F_ADDR = 2;
+
+} // namespace
+
+std::vector<unsigned> parse_cpu_list(const std::string& cpu_list)
+{
+    std::vector<unsigned> cpus {};
+    std::istringstream stream { cpu_list };
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        const std::size_t dash = range.find('-');
+        const auto first = static_cast<unsigned>(std::stoul(range.substr(0, dash)));
+        const auto last = dash == std::string::npos ? first : static_cast<unsigned>(std::stoul(range.substr(dash + 1)));
+        for (unsigned cpu = first; cpu <= last; ++cpu) {
+            cpus.emplace_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+std::vector<NumaNode> numa_nodes()
+{
+    std::vector<NumaNode> nodes {};
+    std::error_code error {};
+    for (const auto& entry : std::filesystem::directory_iterator { NODE_DIR, error }) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4
+            || !std::all_of(name.begin() + 4, name.end(), [](const char c) { return c >= '0' && c <= '9'; })) {
+            continue;
+        }
+        std::ifstream cpu_list_file { entry.path() / "cpulist" };
+        std::string cpu_list;
+        std::getline(cpu_list_file, cpu_list);
+        std::vector<unsigned> cpus = parse_cpu_list(cpu_list);
+        // Memory-only nodes, e.g., CXL expanders, cannot run workers.
+        if (!cpus.empty()) {
+            nodes.push_back({ static_cast<unsigned>(std::stoul(name.substr(4))), std::move(cpus) });
+        }
+    }
+    if (nodes.empty()) {
+        NumaNode node { 0, {} };
+        for (unsigned cpu = 0; cpu < std::max(1U, std::thread::hardware_concurrency()); ++cpu) {
+            node.cpus.emplace_back(cpu);
+        }
+        nodes.emplace_back(std::move(node));
+    }
+    std::sort(nodes.begin(), nodes.end(), [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+    return nodes;
+}
+
+void bind_to_cpus(const std::vector<unsigned>& cpus)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const unsigned cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+    // pid 0 is the calling thread.
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        throw std::system_error(errno, std::generic_category(), "Failed to set the CPU affinity");
+    }
+}
+
+void first_touch(void* data, const std::size_t n_bytes)
+{
+    const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    auto* bytes = static_cast<volatile char*>(data);
+    for (std::size_t i = 0; i < n_bytes; i += page_size) {
+        bytes[i] = 0;
+    }
+}
+
+int node_of(const void* address)
+{
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, address, MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+        return -1;
+    }
+    return node;
+}
@@ -0,0 +1,347 @@
+#include "prescreen.hh"
+
+#include "arch_utils.hh"
+
+#include <boost/math/special_functions/gamma.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(BENCH_RAND_ARCH_X86) && (defined(__AVX2__) || defined(__AVX512F__))
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/**
+ * @return Probability that a chi-square statistic with @p df degrees of freedom is at least @p chi2.
+ */
+double chi_square_p_value(const double chi2, const double df) { return boost::math::gamma_q(df / 2, chi2 / 2); }
+
+/**
+ * @return Chi-square statistic of @p counts against a common expected count @p expected.
+ */
+double chi_square_uniform(const std::vector<std::uint64_t>& counts, const double expected)
+{
+    double chi2 = 0;
+    for (const std::uint64_t count : counts) {
+        const double diff = static_cast<double>(count) - expected;
+        chi2 += diff * diff / expected;
+    }
+    return chi2;
+}
+
+/**
+ * dst ^= src << shift, over LC_WORDS-word bit strings, dropping the bits shifted past the end.
+ */
+template <std::size_t N>
+void xor_shifted(std::array<std::uint64_t, N>& dst, const std::array<std::uint64_t, N>& src, const std::size_t shift)
+{
+    const std::size_t word_shift = shift / 64;
+    const unsigned bit_shift = shift % 64;
+    for (std::size_t i = N; i-- > word_shift;) {
+        std::uint64_t bits = src[i - word_shift] << bit_shift;
+        if (bit_shift != 0 && i > word_shift) {
+            bits |= src[i - word_shift - 1] >> (64 - bit_shift);
+        }
+        dst[i] ^= bits;
+    }
+}
+
+/**
+ * Sort @p values by LSD radix sort on bytes, which for a few thousand words is several times faster than std::sort.
+ */
+void radix_sort(std::vector<std::uint32_t>& values, std::vector<std::uint32_t>& scratch)
+{
+    scratch.resize(values.size());
+    for (unsigned shift = 0; shift < 32; shift += 8) {
+        std::array<std::size_t, 257> offsets {};
+        for (const std::uint32_t value : values) {
+            offsets[((value >> shift) & 0xFF) + 1]++;
+        }
+        for (std::size_t k = 1; k < offsets.size(); ++k) {
+            offsets[k] += offsets[k - 1];
+        }
+        for (const std::uint32_t value : values) {
+            scratch[offsets[(value >> shift) & 0xFF]++] = value;
+        }
+        values.swap(scratch);
+    }
+}
+
+/**
+ * Bit j of below, at and above is set iff weight j is below, at or above 16.
+ */
+struct WeightMasks {
+    std::uint64_t below;
+    std::uint64_t at;
+    std::uint64_t above;
+};
+
+/**
+ * Masks of @p weights[0, @p n), n <= 64, 64 weights at a time with AVX-512BW where available.
+ */
+WeightMasks weight_masks(const std::uint8_t* weights, const std::size_t n)
+{
+    WeightMasks masks { 0, 0, 0 };
+#if defined(BENCH_RAND_ARCH_X86) && defined(__AVX512BW__)
+    if (n == 64) {
+        const __m512i v = _mm512_loadu_si512(weights);
+        const __m512i mean = _mm512_set1_epi8(16);
+        masks.below = _mm512_cmplt_epu8_mask(v, mean);
+        masks.above = _mm512_cmpgt_epu8_mask(v, mean);
+        masks.at = ~(masks.below | masks.above);
+        return masks;
+    }
+#endif
+    for (std::size_t j = 0; j < n; ++j) {
+        masks.below |= static_cast<std::uint64_t>(weights[j] < 16) << j;
+        masks.at |= static_cast<std::uint64_t>(weights[j] == 16) << j;
+        masks.above |= static_cast<std::uint64_t>(weights[j] > 16) << j;
+    }
+    return masks;
+}
+
+/**
+ * Add the classes of the pairs (@p weights[2i], @p weights[2i + 1]) for i < @p n_pairs to the 3 x 3 table @p cells,
+ * by popcounts over the class masks of 32 pairs at a time instead of one increment per pair.
+ */
+void count_weight_pairs(const std::uint8_t* weights, const std::size_t n_pairs, std::array<std::uint64_t, 9>& cells)
+{
+    constexpr std::uint64_t EVEN = 0x5555555555555555ULL;
+    for (std::size_t begin = 0; begin < 2 * n_pairs; begin += 64) {
+        const WeightMasks masks = weight_masks(weights + begin, std::min<std::size_t>(64, 2 * n_pairs - begin));
+        const std::array<std::uint64_t, 3> firsts { masks.below & EVEN, masks.at & EVEN, masks.above & EVEN };
+        const std::array<std::uint64_t, 3> seconds { (masks.below >> 1) & EVEN, (masks.at >> 1) & EVEN,
+            (masks.above >> 1) & EVEN };
+        for (std::size_t a = 0; a < 3; ++a) {
+            for (std::size_t b = 0; b < 3; ++b) {
+                cells[3 * a + b] += static_cast<std::uint64_t>(__builtin_popcountll(firsts[a] & seconds[b]));
+            }
+        }
+    }
+}
+
+} // namespace
+
+Prescreen::Prescreen(const std::size_t max_birthday_samples, const std::size_t max_lc_blocks)
+    : max_birthday_samples_ { max_birthday_samples }
+    , max_lc_blocks_ { max_lc_blocks }
+{
+    birthdays_.reserve(BIRTHDAYS);
+}
+
+void Prescreen::update(const std::uint32_t* words, const std::size_t n)
+{
+    n_words_ += n;
+
+    std::uint64_t* bytes = byte_counts_.data();
+    std::uint64_t* halves = half_counts_.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint32_t word = words[i];
+        // One table per position, so that consecutive increments rarely hit the same counter.
+        bytes[word & 0xFF]++;
+        bytes[256 + ((word >> 8) & 0xFF)]++;
+        bytes[512 + ((word >> 16) & 0xFF)]++;
+        bytes[768 + (word >> 24)]++;
+        halves[word & 0xFFFF]++;
+        halves[65536 + (word >> 16)]++;
+    }
+
+    // A weight left unpaired by the previous block leads this one, so pairs always start at an even index.
+    const std::size_t n_weights = n + (has_pending_weight_ ? 1 : 0);
+    weights_.resize(n_weights);
+    if (has_pending_weight_) {
+        weights_[0] = pending_weight_;
+    }
+    hamming_weights(words, n, weights_.data() + n_weights - n);
+    count_weight_pairs(weights_.data(), n_weights / 2, weight_pairs_);
+    has_pending_weight_ = n_weights % 2 == 1;
+    if (has_pending_weight_) {
+        pending_weight_ = weights_[n_weights - 1];
+    }
+
+    update_birthdays(words, n);
+    update_linear_complexity(words, n);
+}
+
+void Prescreen::update_birthdays(const std::uint32_t* words, const std::size_t n)
+{
+    for (std::size_t i = 0; i < n && n_birthday_samples_ < max_birthday_samples_; ++i) {
+        birthdays_.push_back(words[i]);
+        if (birthdays_.size() < BIRTHDAYS) {
+            continue;
+        }
+        radix_sort(birthdays_, birthday_scratch_);
+        for (std::size_t j = 0; j + 1 < BIRTHDAYS; ++j) {
+            birthdays_[j] = birthdays_[j + 1] - birthdays_[j];
+        }
+        birthdays_.pop_back();
+        radix_sort(birthdays_, birthday_scratch_);
+        for (std::size_t j = 1; j < birthdays_.size(); ++j) {
+            n_duplicate_spacings_ += birthdays_[j] == birthdays_[j - 1] ? 1 : 0;
+        }
+        birthdays_.clear();
+        n_birthday_samples_++;
+    }
+}
+
+void Prescreen::update_linear_complexity(const std::uint32_t* words, const std::size_t n)
+{
+    for (std::size_t i = 0; i < n && n_lc_blocks_ < max_lc_blocks_; ++i) {
+        lc_bits_[lc_position_ / 64] |= static_cast<std::uint64_t>(words[i] & 1U) << (lc_position_ % 64);
+        if (++lc_position_ == LC_BLOCK_BITS) {
+            end_lc_block();
+        }
+    }
+}
+
+void Prescreen::end_lc_block()
+{
+    // Berlekamp-Massey over GF(2). Bit i of recent is s[n - i], so the discrepancy of connection polynomial c, whose
+    // bit 0 is always set, is the parity of c & recent.
+    std::array<std::uint64_t, LC_WORDS> c {};
+    std::array<std::uint64_t, LC_WORDS> b {};
+    std::array<std::uint64_t, LC_WORDS> recent {};
+    c[0] = 1;
+    b[0] = 1;
+    std::size_t complexity = 0;
+    std::size_t last_change = 0;
+    bool changed = false;
+    for (std::size_t n = 0; n < LC_BLOCK_BITS; ++n) {
+        for (std::size_t k = LC_WORDS; k-- > 1;) {
+            recent[k] = (recent[k] << 1) | (recent[k - 1] >> 63);
+        }
+        recent[0] = (recent[0] << 1) | ((lc_bits_[n / 64] >> (n % 64)) & 1U);
+        unsigned parity = 0;
+        for (std::size_t k = 0; k < LC_WORDS; ++k) {
+            parity ^= static_cast<unsigned>(__builtin_popcountll(c[k] & recent[k]));
+        }
+        if ((parity & 1U) == 0) {
+            continue;
+        }
+        const auto previous = c;
+        // Before the first change, b is 1 at position -1, i.e., shifted by n + 1.
+        xor_shifted(c, b, changed ? n - last_change : n + 1);
+        if (2 * complexity <= n) {
+            complexity = n + 1 - complexity;
+            last_change = n;
+            changed = true;
+            b = previous;
+        }
+    }
+
+    // For an even block length, T = L - M / 2 takes integer values, classified as in NIST SP 800-22.
+    const auto t = static_cast<std::ptrdiff_t>(complexity) - static_cast<std::ptrdiff_t>(LC_BLOCK_BITS / 2);
+    lc_classes_[static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(t, -3, 3) + 3)]++;
+
+    lc_bits_.fill(0);
+    lc_position_ = 0;
+    n_lc_blocks_++;
+}
+
+std::vector<Prescreen::Result> Prescreen::results() const
+{
+    std::vector<Result> results {};
+    const auto n = static_cast<double>(n_words_);
+
+    // At least 5 expected counts per cell for the chi-square approximation.
+    if (n_words_ >= 5 * 256) {
+        const double chi2 = chi_square_uniform(byte_counts_, n / 256);
+        results.push_back({ "byte chi-square", chi_square_p_value(chi2, 4 * 255) });
+    }
+    if (n_words_ >= 5 * 65536) {
+        const double chi2 = chi_square_uniform(half_counts_, n / 65536);
+        results.push_back({ "word chi-square", chi_square_p_value(chi2, 2 * 65535) });
+    }
+
+    if (n_birthday_samples_ > 0) {
+        const auto birthdays = static_cast<double>(BIRTHDAYS);
+        const double mean
+            = static_cast<double>(n_birthday_samples_) * birthdays * birthdays * birthdays / std::ldexp(1.0, 34);
+        // For a Poisson variable, P(X >= k) is the regularized lower incomplete gamma function P(k, mean) and
+        // P(X <= k) the upper one Q(k + 1, mean). Two-sided, as too few duplicates are as suspect as too many.
+        const auto k = static_cast<double>(n_duplicate_spacings_);
+        const double p_at_least = n_duplicate_spacings_ == 0 ? 1.0 : boost::math::gamma_p(k, mean);
+        const double p_at_most = boost::math::gamma_q(k + 1, mean);
+        results.push_back({ "birthday spacings", std::min(p_at_least, p_at_most) });
+    }
+
+    std::uint64_t n_pairs = 0;
+    for (const std::uint64_t count : weight_pairs_) {
+        n_pairs += count;
+    }
+    if (n_pairs >= 1000) {
+        // P(weight == 16) = C(32, 16) / 2^32, and the weights below and above 16 are symmetric.
+        const double p_at = 601080390.0 / std::ldexp(1.0, 32);
+        const std::array<double, 3> p { (1 - p_at) / 2, p_at, (1 - p_at) / 2 };
+        double chi2 = 0;
+        for (std::size_t cell = 0; cell < weight_pairs_.size(); ++cell) {
+            const double expected = static_cast<double>(n_pairs) * p[cell / 3] * p[cell % 3];
+            const double diff = static_cast<double>(weight_pairs_[cell]) - expected;
+            chi2 += diff * diff / expected;
+        }
+        results.push_back({ "Hamming-weight dependency", chi_square_p_value(chi2, 8) });
+    }
+
+    // NIST SP 800-22 asks for at least 200 blocks.
+    if (n_lc_blocks_ >= 200) {
+        constexpr std::array<double, 7> PI { 1.0 / 96, 1.0 / 32, 1.0 / 8, 1.0 / 2, 1.0 / 4, 1.0 / 16, 1.0 / 48 };
+        double chi2 = 0;
+        for (std::size_t k = 0; k < PI.size(); ++k) {
+            const double expected = static_cast<double>(n_lc_blocks_) * PI[k];
+            const double diff = static_cast<double>(lc_classes_[k]) - expected;
+            chi2 += diff * diff / expected;
+        }
+        results.push_back({ "linear complexity, bit 0", chi_square_p_value(chi2, 6) });
+    }
+    return results;
+}
+
+void Prescreen::hamming_weights_scalar(const std::uint32_t* words, const std::size_t n, std::uint8_t* weights)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        weights[i] = static_cast<std::uint8_t>(__builtin_popcount(words[i]));
+    }
+}
+
+void Prescreen::hamming_weights(const std::uint32_t* words, const std::size_t n, std::uint8_t* weights)
+{
+#if defined(BENCH_RAND_ARCH_X86) && defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+    // The masked form of the narrowing is used as the unmasked one triggers -Wmaybe-uninitialized in GCC's headers.
+    constexpr __mmask16 ALL_LANES = 0xFFFF;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m512i counts = _mm512_popcnt_epi32(_mm512_loadu_si512(words + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(weights + i), _mm512_maskz_cvtepi32_epi8(ALL_LANES, counts));
+    }
+    hamming_weights_scalar(words + i, n - i, weights + i);
+#elif defined(BENCH_RAND_ARCH_X86) && defined(__AVX2__)
+    // Weights of each nibble from a table, summed to bytes, then to 32-bit lanes, then packed back to bytes.
+    const __m256i table = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_nibbles = _mm256_set1_epi8(0x0F);
+    const __m256i ones_8 = _mm256_set1_epi8(1);
+    const __m256i ones_16 = _mm256_set1_epi16(1);
+    const auto lane_weights = [&](const std::uint32_t* from) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from));
+        const __m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low_nibbles));
+        const __m256i high = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_nibbles));
+        return _mm256_madd_epi16(_mm256_maddubs_epi16(_mm256_add_epi8(low, high), ones_8), ones_16);
+    };
+    // packs works within 128-bit lanes, which leaves the 4-byte groups in this order.
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i w01 = _mm256_packs_epi32(lane_weights(words + i), lane_weights(words + i + 8));
+        const __m256i w23 = _mm256_packs_epi32(lane_weights(words + i + 16), lane_weights(words + i + 24));
+        const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_packs_epi16(w01, w23), order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(weights + i), packed);
+    }
+    hamming_weights_scalar(words + i, n - i, weights + i);
+#else
+    hamming_weights_scalar(words, n, weights);
+#endif
+}
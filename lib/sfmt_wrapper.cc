@@ -2,6 +2,7 @@
 
 #include <SFMT.h>
 
+#include <cstddef>
 #include <cstdlib>
 #include <vector>
 
@@ -24,4 +25,8 @@ void SFMTBulkRandomDevice::gen(std::vector<SFMTBulkRandomDevice::result_type>& v
 {
     sfmt_fill_array32(static_cast<sfmt_t*>(sfmt), vec.data(), static_cast<int>(vec.size()));
 }
+void SFMTBulkRandomDevice::gen(SFMTBulkRandomDevice::result_type* out, const std::size_t n)
+{
+    sfmt_fill_array32(static_cast<sfmt_t*>(sfmt), out, static_cast<int>(n));
+}
 SFMTBulkRandomDevice::~SFMTBulkRandomDevice() { std::free(sfmt); }
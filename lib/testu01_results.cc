@@ -0,0 +1,179 @@
+#include "testu01_results.hh"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <optional>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const std::string CSV_HEADER = "generator,version,seed,adaptor,battery,test,name,p_value,passed";
+constexpr std::size_t N_CSV_FIELDS = 9;
+const std::string TABLE_RULE = " ----------------------------------------------";
+
+std::string csv_escape(const std::string& field)
+{
+    if (field.find_first_of(",\"\n") == std::string::npos) {
+        return field;
+    }
+    std::string escaped = "\"";
+    for (const char c : field) {
+        escaped += c == '"' ? "\"\"" : std::string(1, c);
+    }
+    return escaped + "\"";
+}
+
+/**
+ * Split one CSV line, without embedded newlines, into its unquoted fields.
+ */
+std::vector<std::string> csv_split(const std::string& line)
+{
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (std::size_t i = 0; i < line.size(); i++) {
+        const char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                i++;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                fields.back() += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.emplace_back();
+        } else {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+} // namespace
+
+bool TestU01Key::operator<(const TestU01Key& other) const
+{
+    return std::tie(generator, version, seed, adaptor, battery)
+        < std::tie(other.generator, other.version, other.seed, other.adaptor, other.battery);
+}
+
+std::optional<std::vector<TestU01Record>> parse_testu01_summary(const std::string& output)
+{
+    const std::size_t summary = output.rfind("========= Summary results of");
+    if (summary == std::string::npos) {
+        return std::nullopt;
+    }
+    std::istringstream lines { output.substr(summary) };
+    std::string line;
+    std::vector<TestU01Record> records {};
+    bool in_table = false;
+    bool table_closed = false;
+    // Test number, name padded to 30 columns, then the p-value, which may contain spaces like the name: p-values near 1
+    // are printed as "1 - " and 1 - p right-aligned in 7 columns, e.g., "1 -  4.4e-5".
+    const std::regex row { R"(^\s*(\d+)\s+(.+?)\s+(?:1 -\s+(\S+)|(\S+))\s*$)" };
+    while (std::getline(lines, line)) {
+        if (line == " All tests were passed" || line == " All other tests were passed") {
+            records.push_back({ 0, TESTU01_ALL_OTHER, "", true });
+            return records;
+        }
+        if (line == TABLE_RULE) {
+            in_table = !in_table;
+            table_closed = !in_table;
+            continue;
+        }
+        std::smatch match;
+        if (in_table && std::regex_match(line, match, row)) {
+            const std::string p_value = match[3].matched ? "1 - " + match[3].str() : match[4].str();
+            records.push_back({ std::stoi(match[1]), match[2], p_value, false });
+        }
+    }
+    // Without a passed line when every statistic failed: the closing rule then ends the summary.
+    return table_closed ? std::optional(records) : std::nullopt;
+}
+
+std::string format_testu01_records(const std::vector<TestU01Record>& records)
+{
+    if (records.size() == 1 && records.front().passed) {
+        return " All tests were passed\n";
+    }
+    std::ostringstream table;
+    table << "       Test                          p-value\n" << TABLE_RULE << "\n";
+    for (const auto& record : records) {
+        if (!record.passed) {
+            table << " " << std::setw(2) << record.test << "  " << std::left << std::setw(30) << record.name
+                  << std::right << std::setw(8) << record.p_value << "\n";
+        }
+    }
+    table << TABLE_RULE << "\n";
+    if (!records.empty() && records.back().passed) {
+        table << " All other tests were passed\n";
+    }
+    return table.str();
+}
+
+TestU01ResultStore::TestU01ResultStore(std::string path)
+    : path_(std::move(path))
+{
+    std::ifstream f { path_ };
+    std::string line;
+    if (!f || !std::getline(f, line)) {
+        return;
+    }
+    if (line != CSV_HEADER) {
+        throw std::runtime_error("Unexpected header in " + path_);
+    }
+    while (std::getline(f, line)) {
+        const std::vector<std::string> fields = csv_split(line);
+        if (fields.size() != N_CSV_FIELDS) {
+            throw std::runtime_error("Malformed line in " + path_ + ": " + line);
+        }
+        const TestU01Key key { fields[0], fields[1], std::stoull(fields[2]), fields[3], fields[4] };
+        results_[key].push_back({ std::stoi(fields[5]), fields[6], fields[7], fields[8] == "1" });
+    }
+}
+
+const std::vector<TestU01Record>* TestU01ResultStore::find(const TestU01Key& key) const
+{
+    const auto it = results_.find(key);
+    return it == results_.end() ? nullptr : &it->second;
+}
+
+void TestU01ResultStore::put(const TestU01Key& key, std::vector<TestU01Record> records)
+{
+    results_[key] = std::move(records);
+}
+
+void TestU01ResultStore::save() const
+{
+    const std::string temp_path = path_ + ".tmp";
+    {
+        std::ofstream f { temp_path, std::ios::binary };
+        f << CSV_HEADER << "\n";
+        for (const auto& [key, records] : results_) {
+            for (const auto& record : records) {
+                f << csv_escape(key.generator) << "," << csv_escape(key.version) << "," << key.seed << ","
+                  << csv_escape(key.adaptor) << "," << csv_escape(key.battery) << "," << record.test << ","
+                  << csv_escape(record.name) << "," << csv_escape(record.p_value) << "," << (record.passed ? 1 : 0)
+                  << "\n";
+            }
+        }
+    }
+    if (std::rename(temp_path.c_str(), path_.c_str()) != 0) {
+        throw std::system_error(errno, std::generic_category(), "Failed to rename " + temp_path);
+    }
+}